@@ -5,8 +5,12 @@ ffibuilder = cffi.FFI()
 
 c_headers = [
     "lithium/gimli.h",
+    "lithium/iovec.h",
     "lithium/gimli_state.h",
     "lithium/gimli_hash.h",
+    "lithium/gimli_mac.h",
+    "lithium/gimli_tree_hash.h",
+    "lithium/merkle.h",
     "lithium/sign.h",
 ]
 
@@ -18,9 +22,16 @@ ffibuilder.set_source(
         "src/gimli.c",
         "src/gimli_common.c",
         "src/gimli_hash.c",
+        "src/gimli_mac.c",
+        "src/gimli_tree_hash.c",
         "src/fe.c",
+        "src/fe25.c",
+        "src/fe51.c",
         "src/memzero.c",
+        "src/merkle.c",
         "src/x25519.c",
+        "src/x25519_base.c",
+        "src/x25519_batch.c",
         "src/sign.c",
     ],
 )
@@ -97,6 +97,33 @@ int hydro_hash_hash(uint8_t *out, size_t out_len, const void *in_,
     return 0;
 }
 
+int hydro_hash_ctx_prepare(hydro_hash_ctx *prepared,
+                           const char ctx[hydro_hash_CONTEXTBYTES],
+                           const uint8_t key[hydro_hash_KEYBYTES])
+{
+    return hydro_hash_init(&prepared->init_st, ctx, key);
+}
+
+int hydro_hash_init_prepared(hydro_hash_state *state,
+                             const hydro_hash_ctx *prepared)
+{
+    gimli_hash_clone(state, &prepared->init_st);
+    return 0;
+}
+
+int hydro_hash_hash_prepared(uint8_t *out, size_t out_len, const void *in_,
+                             size_t in_len, const hydro_hash_ctx *prepared)
+{
+    hydro_hash_state st;
+    if (hydro_hash_init_prepared(&st, prepared) != 0 ||
+        hydro_hash_update(&st, in_, in_len) != 0 ||
+        hydro_hash_final(&st, out, out_len) != 0)
+    {
+        return -1;
+    }
+    return 0;
+}
+
 #define hydro_sign_CHALLENGEBYTES 32
 #define hydro_sign_NONCEBYTES 32
 #define hydro_sign_PREHASHBYTES 64
@@ -111,7 +138,16 @@ void hydro_sign_keygen(hydro_sign_keypair *kp)
 int hydro_sign_init(hydro_sign_state *state,
                     const char ctx[hydro_sign_CONTEXTBYTES])
 {
-    return hydro_hash_init(&state->hash_st, ctx, NULL);
+    hydro_hash_ctx prepared;
+    return hydro_hash_ctx_prepare(&prepared, ctx, NULL) != 0
+               ? -1
+               : hydro_sign_init_prepared(state, &prepared);
+}
+
+int hydro_sign_init_prepared(hydro_sign_state *state,
+                             const hydro_hash_ctx *prepared)
+{
+    return hydro_hash_init_prepared(&state->hash_st, prepared);
 }
 
 int hydro_sign_update(hydro_sign_state *state, const void *m_, size_t mlen)
@@ -119,13 +155,40 @@ int hydro_sign_update(hydro_sign_state *state, const void *m_, size_t mlen)
     return hydro_hash_update(&state->hash_st, m_, mlen);
 }
 
+/*
+ * The challenge hash always uses no context and no key, so its initial state is
+ * a constant: hydro_hash_ctx_prepare(&challenge_ctx, NULL, NULL). The tests
+ * check signatures against a challenge computed with hydro_hash_init.
+ */
+static const hydro_hash_ctx challenge_ctx = {
+    .init_st =
+        {
+            .state =
+                {
+                    UINT32_C(0xBCE8718E),
+                    UINT32_C(0x67CDD2D4),
+                    UINT32_C(0x8EE33B7C),
+                    UINT32_C(0x47174817),
+                    UINT32_C(0xB069897D),
+                    UINT32_C(0xC847FC60),
+                    UINT32_C(0x2EF68F23),
+                    UINT32_C(0x82FC5F8A),
+                    UINT32_C(0x1AAA2E4F),
+                    UINT32_C(0x6641C933),
+                    UINT32_C(0xB7355231),
+                    UINT32_C(0xC7F12516),
+                },
+            .offset = 0,
+        },
+};
+
 static void hydro_sign_challenge(uint8_t challenge[hydro_sign_CHALLENGEBYTES],
                                  const uint8_t nonce[hydro_sign_NONCEBYTES],
                                  const uint8_t pk[hydro_sign_PUBLICKEYBYTES],
                                  const uint8_t prehash[hydro_sign_PREHASHBYTES])
 {
     hydro_hash_state st;
-    hydro_hash_init(&st, NULL, NULL);
+    hydro_hash_init_prepared(&st, &challenge_ctx);
     hydro_hash_update(&st, nonce, hydro_sign_NONCEBYTES);
     hydro_hash_update(&st, pk, hydro_sign_PUBLICKEYBYTES);
     hydro_hash_update(&st, prehash, hydro_sign_PREHASHBYTES);
@@ -176,13 +239,13 @@ int hydro_sign_final_verify(hydro_sign_state *state,
     return x25519_verify(sig, challenge, nonce, pk) ? 0 : -1;
 }
 
-int hydro_sign_create(uint8_t csig[hydro_sign_BYTES], const void *m_,
-                      size_t mlen, const char ctx[hydro_sign_CONTEXTBYTES],
-                      const uint8_t sk[hydro_sign_SECRETKEYBYTES])
+int hydro_sign_create_prepared(uint8_t csig[hydro_sign_BYTES], const void *m_,
+                               size_t mlen, const hydro_hash_ctx *prepared,
+                               const uint8_t sk[hydro_sign_SECRETKEYBYTES])
 {
     hydro_sign_state st;
 
-    if (hydro_sign_init(&st, ctx) != 0 ||
+    if (hydro_sign_init_prepared(&st, prepared) != 0 ||
         hydro_sign_update(&st, m_, mlen) != 0 ||
         hydro_sign_final_create(&st, csig, sk) != 0)
     {
@@ -191,13 +254,14 @@ int hydro_sign_create(uint8_t csig[hydro_sign_BYTES], const void *m_,
     return 0;
 }
 
-int hydro_sign_verify(const uint8_t csig[hydro_sign_BYTES], const void *m_,
-                      size_t mlen, const char ctx[hydro_sign_CONTEXTBYTES],
-                      const uint8_t pk[hydro_sign_PUBLICKEYBYTES])
+int hydro_sign_verify_prepared(const uint8_t csig[hydro_sign_BYTES],
+                               const void *m_, size_t mlen,
+                               const hydro_hash_ctx *prepared,
+                               const uint8_t pk[hydro_sign_PUBLICKEYBYTES])
 {
     hydro_sign_state st;
 
-    if (hydro_sign_init(&st, ctx) != 0 ||
+    if (hydro_sign_init_prepared(&st, prepared) != 0 ||
         hydro_sign_update(&st, m_, mlen) != 0 ||
         hydro_sign_final_verify(&st, csig, pk) != 0)
     {
@@ -205,3 +269,29 @@ int hydro_sign_verify(const uint8_t csig[hydro_sign_BYTES], const void *m_,
     }
     return 0;
 }
+
+int hydro_sign_create(uint8_t csig[hydro_sign_BYTES], const void *m_,
+                      size_t mlen, const char ctx[hydro_sign_CONTEXTBYTES],
+                      const uint8_t sk[hydro_sign_SECRETKEYBYTES])
+{
+    hydro_hash_ctx prepared;
+
+    if (hydro_hash_ctx_prepare(&prepared, ctx, NULL) != 0)
+    {
+        return -1;
+    }
+    return hydro_sign_create_prepared(csig, m_, mlen, &prepared, sk);
+}
+
+int hydro_sign_verify(const uint8_t csig[hydro_sign_BYTES], const void *m_,
+                      size_t mlen, const char ctx[hydro_sign_CONTEXTBYTES],
+                      const uint8_t pk[hydro_sign_PUBLICKEYBYTES])
+{
+    hydro_hash_ctx prepared;
+
+    if (hydro_hash_ctx_prepare(&prepared, ctx, NULL) != 0)
+    {
+        return -1;
+    }
+    return hydro_sign_verify_prepared(csig, m_, mlen, &prepared, pk);
+}
@@ -54,6 +54,25 @@ int hydro_hash_hash(uint8_t *out, size_t out_len, const void *in_,
                     size_t in_len, const char ctx[hydro_hash_CONTEXTBYTES],
                     const uint8_t key[hydro_hash_KEYBYTES]);
 
+/*
+ * A state initialized for a (context, key) pair, which can be reused to start
+ * any number of hashes without absorbing the context and key again.
+ */
+typedef struct hydro_hash_ctx
+{
+    hydro_hash_state init_st;
+} hydro_hash_ctx;
+
+int hydro_hash_ctx_prepare(hydro_hash_ctx *prepared,
+                           const char ctx[hydro_hash_CONTEXTBYTES],
+                           const uint8_t key[hydro_hash_KEYBYTES]);
+
+int hydro_hash_init_prepared(hydro_hash_state *state,
+                             const hydro_hash_ctx *prepared);
+
+int hydro_hash_hash_prepared(uint8_t *out, size_t out_len, const void *in_,
+                             size_t in_len, const hydro_hash_ctx *prepared);
+
 #define hydro_sign_BYTES 64
 #define hydro_sign_CONTEXTBYTES 8
 #define hydro_sign_PUBLICKEYBYTES 32
@@ -76,6 +95,10 @@ void hydro_sign_keygen(hydro_sign_keypair *kp);
 int hydro_sign_init(hydro_sign_state *state,
                     const char ctx[hydro_sign_CONTEXTBYTES]);
 
+/* prepared must be for the signing context, with no key. */
+int hydro_sign_init_prepared(hydro_sign_state *state,
+                             const hydro_hash_ctx *prepared);
+
 int hydro_sign_update(hydro_sign_state *state, const void *m_, size_t mlen);
 
 int hydro_sign_final_create(hydro_sign_state *state,
@@ -96,6 +119,20 @@ int hydro_sign_verify(const uint8_t csig[hydro_sign_BYTES], const void *m_,
                       const uint8_t pk[hydro_sign_PUBLICKEYBYTES])
     _hydro_attr_warn_unused_result_;
 
+/*
+ * hydro_sign_create and hydro_sign_verify with a context prepared once, as for
+ * hydro_sign_init_prepared, for callers that sign or verify many messages.
+ */
+int hydro_sign_create_prepared(uint8_t csig[hydro_sign_BYTES], const void *m_,
+                               size_t mlen, const hydro_hash_ctx *prepared,
+                               const uint8_t sk[hydro_sign_SECRETKEYBYTES]);
+
+int hydro_sign_verify_prepared(const uint8_t csig[hydro_sign_BYTES],
+                               const void *m_, size_t mlen,
+                               const hydro_hash_ctx *prepared,
+                               const uint8_t pk[hydro_sign_PUBLICKEYBYTES])
+    _hydro_attr_warn_unused_result_;
+
 #ifdef __cplusplus
 }
 #endif
@@ -1,7 +1,11 @@
+#include "hydrogen.h"
+
 #include <lithium/random.h>
 #include <lithium/sign.h>
+#include <lithium/x25519.h>
 
 #include <assert.h>
+#include <string.h>
 
 /*
  * Part of liblithium, under the Apache License v2.0.
@@ -64,7 +68,127 @@ static void test_sign(void)
     assert(lith_sign_verify(sig, msg, 0, public_key));
 }
 
+static void test_hash_prepared(void)
+{
+    static const uint8_t keyed_kat[32] = {
+        0x03, 0xBB, 0x29, 0xE8, 0x84, 0x3D, 0x4D, 0xB1, 0x5C, 0x7F, 0x5F,
+        0x1E, 0xF9, 0xB3, 0x1C, 0xF3, 0x8A, 0x7E, 0xBA, 0x09, 0x09, 0x1B,
+        0x3D, 0x67, 0x6C, 0x8C, 0xC2, 0xB9, 0x27, 0x86, 0xEC, 0x14,
+    };
+    static const uint8_t unkeyed_kat[32] = {
+        0xEB, 0x07, 0xF0, 0xE0, 0x70, 0x80, 0x0B, 0x90, 0xF9, 0xD3, 0x5C,
+        0x78, 0x20, 0x9C, 0x49, 0xB3, 0x6D, 0x01, 0x93, 0x41, 0xFA, 0xAD,
+        0x2F, 0xC6, 0xAF, 0xF9, 0x87, 0x17, 0xAB, 0x77, 0x4F, 0x6A,
+    };
+    static const char ctx[hydro_hash_CONTEXTBYTES] = "lithtest";
+    static const char kat_msg[] = "hydro sign known answer";
+    unsigned char msg[100];
+    uint8_t key[hydro_hash_KEYBYTES];
+    uint8_t h[32], hp[32];
+    hydro_hash_ctx prepared;
+    hydro_hash_state st;
+    size_t i;
+
+    for (i = 0; i < sizeof key; ++i)
+    {
+        key[i] = (uint8_t)i;
+    }
+    assert(hydro_hash_hash(h, sizeof h, kat_msg, sizeof kat_msg - 1, ctx,
+                           key) == 0);
+    assert(memcmp(h, keyed_kat, sizeof h) == 0);
+    assert(hydro_hash_hash(h, sizeof h, kat_msg, sizeof kat_msg - 1, NULL,
+                           NULL) == 0);
+    assert(memcmp(h, unkeyed_kat, sizeof h) == 0);
+
+    lith_random_bytes(msg, sizeof msg);
+    lith_random_bytes(key, sizeof key);
+    for (i = 0; i < 4; ++i)
+    {
+        const char *c = (i & 1) ? ctx : NULL;
+        const uint8_t *k = (i & 2) ? key : NULL;
+        assert(hydro_hash_ctx_prepare(&prepared, c, k) == 0);
+        assert(hydro_hash_hash(h, sizeof h, msg, sizeof msg, c, k) == 0);
+        assert(hydro_hash_hash_prepared(hp, sizeof hp, msg, sizeof msg,
+                                        &prepared) == 0);
+        assert(memcmp(h, hp, sizeof h) == 0);
+
+        /* The prepared state is not consumed by a hash. */
+        assert(hydro_hash_init_prepared(&st, &prepared) == 0);
+        assert(hydro_hash_update(&st, msg, 7) == 0);
+        assert(hydro_hash_update(&st, &msg[7], sizeof msg - 7) == 0);
+        assert(hydro_hash_final(&st, hp, sizeof hp) == 0);
+        assert(memcmp(h, hp, sizeof h) == 0);
+    }
+}
+
+static void test_sign_kat(void)
+{
+    static const uint8_t pk[hydro_sign_PUBLICKEYBYTES] = {
+        0xE1, 0x92, 0xC4, 0xC3, 0xE3, 0x59, 0xCF, 0x7F, 0x38, 0xEA, 0x28,
+        0xB7, 0xBD, 0x74, 0x8A, 0x2B, 0x16, 0xD2, 0x4B, 0x2C, 0xC8, 0x8B,
+        0x9A, 0x29, 0x4C, 0x6D, 0xDA, 0x87, 0x81, 0x10, 0xBC, 0x48,
+    };
+    static const uint8_t sig[hydro_sign_BYTES] = {
+        0xE8, 0x35, 0xFE, 0xB4, 0x2A, 0xD5, 0x68, 0x0E, 0xE2, 0xD4, 0xE1,
+        0xE8, 0x25, 0xDA, 0xB3, 0x90, 0x9A, 0xBE, 0xBB, 0x79, 0x52, 0x05,
+        0x80, 0x7F, 0xE5, 0x4B, 0xC6, 0x48, 0xC3, 0x9D, 0xA7, 0x45, 0x4F,
+        0x25, 0x96, 0x8F, 0x9D, 0x90, 0xCB, 0x29, 0x8E, 0xD6, 0xD8, 0x95,
+        0xDF, 0xE3, 0x0E, 0x33, 0x15, 0x9A, 0x88, 0x42, 0x7C, 0xA2, 0xB1,
+        0x9A, 0x4E, 0xB3, 0x7C, 0xFA, 0x74, 0xFF, 0x4B, 0x0C,
+    };
+    static const char ctx[hydro_sign_CONTEXTBYTES] = "lithtest";
+    static const char msg[] = "hydro sign known answer";
+    hydro_hash_ctx prepared;
+    hydro_sign_state st;
+
+    assert(hydro_sign_verify(sig, msg, sizeof msg - 1, ctx, pk) == 0);
+
+    assert(hydro_hash_ctx_prepare(&prepared, ctx, NULL) == 0);
+    assert(hydro_sign_init_prepared(&st, &prepared) == 0);
+    assert(hydro_sign_update(&st, msg, sizeof msg - 1) == 0);
+    assert(hydro_sign_final_verify(&st, sig, pk) == 0);
+}
+
+/*
+ * Check a signature against a challenge computed from hydro_hash_init, which
+ * the constant challenge state in hydrogen.c must agree with.
+ */
+static void test_sign_challenge(void)
+{
+    static const char ctx[hydro_sign_CONTEXTBYTES] = "lithtest";
+    unsigned char msg[100];
+    uint8_t csig[hydro_sign_BYTES], prehash[64], challenge[32];
+    hydro_sign_keypair kp;
+    hydro_hash_ctx prepared;
+    hydro_hash_state st;
+
+    lith_random_bytes(msg, sizeof msg);
+    hydro_sign_keygen(&kp);
+    assert(hydro_hash_ctx_prepare(&prepared, ctx, NULL) == 0);
+    assert(hydro_sign_create_prepared(csig, msg, sizeof msg, &prepared,
+                                      kp.sk) == 0);
+    assert(hydro_sign_verify(csig, msg, sizeof msg, ctx, kp.pk) == 0);
+    assert(hydro_sign_verify_prepared(csig, msg, sizeof msg, &prepared,
+                                      kp.pk) == 0);
+
+    assert(hydro_hash_hash(prehash, sizeof prehash, msg, sizeof msg, ctx,
+                           NULL) == 0);
+    assert(hydro_hash_init(&st, NULL, NULL) == 0);
+    assert(hydro_hash_update(&st, csig, 32) == 0);
+    assert(hydro_hash_update(&st, kp.pk, sizeof kp.pk) == 0);
+    assert(hydro_hash_update(&st, prehash, sizeof prehash) == 0);
+    assert(hydro_hash_final(&st, challenge, sizeof challenge) == 0);
+    assert(x25519_verify(&csig[32], challenge, csig, kp.pk));
+
+    msg[0] ^= 1;
+    assert(hydro_sign_verify_prepared(csig, msg, sizeof msg, &prepared,
+                                      kp.pk) != 0);
+}
+
 int main(void)
 {
     test_sign();
+    test_hash_prepared();
+    test_sign_kat();
+    test_sign_challenge();
 }
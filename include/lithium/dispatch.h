@@ -0,0 +1,33 @@
+#ifndef LITHIUM_DISPATCH_H
+#define LITHIUM_DISPATCH_H
+
+/*
+ * Part of liblithium, under the Apache License v2.0.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Instruction set levels for builds with runtime dispatch (LITH_DISPATCH).
+ * Each level includes the ones below it.
+ */
+#define LITH_LEVEL_SCALAR 0
+#define LITH_LEVEL_SSE2 1
+#define LITH_LEVEL_SSSE3 2
+#define LITH_LEVEL_AVX2 3   /* AVX2 and BMI2 */
+#define LITH_LEVEL_AVX512 4 /* AVX-512F and AVX-512VL */
+
+/*
+ * Returns the level of the kernels in use. The first call to this or any
+ * dispatched function binds the best level supported by the running CPU.
+ */
+int lith_dispatch_level(void);
+
+/*
+ * Bind the kernels for the given level, or for the best level supported by the
+ * running CPU if that is lower. Returns the level that was bound. This is meant
+ * for testing and benchmarking, and must not be called concurrently with other
+ * liblithium functions.
+ */
+int lith_dispatch_force(int level);
+
+#endif /* LITHIUM_DISPATCH_H */
@@ -14,6 +14,16 @@
 
 void gimli(uint32_t state[GIMLI_WORDS]);
 
+/*
+ * Apply the Gimli permutation to 4 or 8 independent states at once.
+ * The result is the same as calling gimli on each state in turn, but the
+ * states are permuted in lockstep in vector lanes when vectorization is
+ * enabled.
+ */
+void gimli_x4(uint32_t states[4][GIMLI_WORDS]);
+
+void gimli_x8(uint32_t states[8][GIMLI_WORDS]);
+
 /* cffi:end */
 
 #endif /* LITHIUM_GIMLI_H */
@@ -7,6 +7,7 @@
  */
 
 #include <lithium/gimli_state.h>
+#include <lithium/iovec.h>
 
 #include <stdbool.h>
 #include <stddef.h>
@@ -27,14 +28,33 @@ void gimli_aead_final_ad(gimli_state *g);
 void gimli_aead_encrypt_update(gimli_state *g, unsigned char *c,
                                const unsigned char *m, size_t len);
 
+/*
+ * Encrypt or decrypt the concatenation of n input fragments, writing the output
+ * for in[i] to out[i], which must have room for in[i].len bytes and may be the
+ * same buffer as in[i].base.
+ */
+void gimli_aead_encrypt_updatev(gimli_state *g, unsigned char *const out[],
+                                const struct lith_iovec *in, size_t n);
+
 void gimli_aead_encrypt_final(gimli_state *g, unsigned char *t, size_t tlen);
 
 void gimli_aead_decrypt_update(gimli_state *g, unsigned char *m,
                                const unsigned char *c, size_t len);
 
+void gimli_aead_decrypt_updatev(gimli_state *g, unsigned char *const out[],
+                                const struct lith_iovec *in, size_t n);
+
 bool gimli_aead_decrypt_final(gimli_state *g, const unsigned char *t,
                               size_t tlen);
 
+/*
+ * Absorb ciphertext without decrypting it. Absorbing the plaintext sets the
+ * rate to the ciphertext, so this leaves g as gimli_aead_decrypt_update would,
+ * and gimli_aead_decrypt_final then checks the tag.
+ */
+void gimli_aead_verify_update(gimli_state *g, const unsigned char *c,
+                              size_t len);
+
 void gimli_aead_encrypt(unsigned char *c, unsigned char *t, size_t tlen,
                         const unsigned char *m, size_t len,
                         const unsigned char *ad, size_t adlen,
@@ -47,4 +67,61 @@ bool gimli_aead_decrypt(unsigned char *m, const unsigned char *c, size_t len,
                         const unsigned char n[GIMLI_AEAD_NONCE_LEN],
                         const unsigned char k[GIMLI_AEAD_KEY_LEN]);
 
+/*
+ * Encrypt count independent packets, writing the ciphertext of m[i], of length
+ * len[i], to c[i] and its tlen-byte tag to t[i], with associated data ad[i] of
+ * length adlen[i], nonce n[i], and key k[i]. The results are the same as
+ * calling gimli_aead_encrypt on each packet, but packets are scheduled into
+ * the lanes of gimli_x8, and a lane is refilled with the next packet as soon
+ * as its tag is written. c[i] may be the same buffer as m[i].
+ */
+void gimli_aead_encrypt_many(unsigned char *const c[], unsigned char *const t[],
+                             size_t tlen, const unsigned char *const m[],
+                             const size_t len[],
+                             const unsigned char *const ad[],
+                             const size_t adlen[],
+                             const unsigned char *const n[],
+                             const unsigned char *const k[], size_t count);
+
+/*
+ * Decrypt count independent packets, as gimli_aead_decrypt does for each one.
+ * If ok is not NULL, ok[i] is set to whether packet i was authentic; the
+ * plaintext of a packet that was not is zeroed. Returns true if every packet
+ * was authentic.
+ */
+bool gimli_aead_decrypt_many(unsigned char *const m[], bool ok[],
+                             const unsigned char *const c[], const size_t len[],
+                             const unsigned char *const t[], size_t tlen,
+                             const unsigned char *const ad[],
+                             const size_t adlen[],
+                             const unsigned char *const n[],
+                             const unsigned char *const k[], size_t count);
+
+/*
+ * Check the tag of a ciphertext without computing its plaintext.
+ */
+bool gimli_aead_verify(const unsigned char *c, size_t len,
+                       const unsigned char *t, size_t tlen,
+                       const unsigned char *ad, size_t adlen,
+                       const unsigned char n[GIMLI_AEAD_NONCE_LEN],
+                       const unsigned char k[GIMLI_AEAD_KEY_LEN]);
+
+/*
+ * Decrypt like gimli_aead_decrypt, but check the tag first, and write to m only
+ * if it is authentic. A forgery costs one pass over c and no writes to m, but
+ * an authentic message takes two passes, so gimli_aead_decrypt is faster when
+ * forgeries are rare.
+ *
+ * c is read once to check the tag and again to decrypt it, so it must not
+ * change in between. If c is in memory that another party can write to, such
+ * as a buffer shared with another process, copy it first, or the plaintext may
+ * not be the one that was authenticated.
+ */
+bool gimli_aead_decrypt_verified(unsigned char *m, const unsigned char *c,
+                                 size_t len, const unsigned char *t,
+                                 size_t tlen, const unsigned char *ad,
+                                 size_t adlen,
+                                 const unsigned char n[GIMLI_AEAD_NONCE_LEN],
+                                 const unsigned char k[GIMLI_AEAD_KEY_LEN]);
+
 #endif /* LITHIUM_GIMLI_AEAD_H */
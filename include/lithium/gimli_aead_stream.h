@@ -0,0 +1,80 @@
+#ifndef LITHIUM_GIMLI_AEAD_STREAM_H
+#define LITHIUM_GIMLI_AEAD_STREAM_H
+
+/*
+ * Part of liblithium, under the Apache License v2.0.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <lithium/gimli_aead.h>
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Chunked streaming AEAD, following the STREAM construction. A message is split
+ * into chunks of chunk_len bytes, and the last chunk may be shorter or empty.
+ * Each chunk is encrypted with gimli_aead_encrypt under its own nonce, which is
+ * the stream's nonce prefix, the 32-bit big-endian chunk index, and a byte that
+ * is 1 for the last chunk and 0 otherwise. Each encrypted chunk is the chunk's
+ * ciphertext followed by its GIMLI_AEAD_TAG_DEFAULT_LEN-byte tag.
+ *
+ * Chunks are independent, so a stream can be split at chunk boundaries into
+ * ranges that are encrypted or decrypted separately, e.g., on different
+ * threads, and any single chunk can be decrypted on its own. The last-chunk
+ * flag makes a truncated stream fail to decrypt, and the index in the nonce
+ * makes reordered chunks fail. Within a range, chunks are processed in the
+ * lanes of gimli_x8 with gimli_aead_encrypt_many and gimli_aead_decrypt_many
+ * when the build has eight-lane vectors.
+ */
+
+#define GIMLI_AEAD_STREAM_PREFIX_LEN 11
+
+void gimli_aead_stream_nonce(unsigned char n[GIMLI_AEAD_NONCE_LEN],
+                             const unsigned char
+                                 prefix[GIMLI_AEAD_STREAM_PREFIX_LEN],
+                             uint32_t index, bool last);
+
+/*
+ * The length of a whole encrypted stream with a len-byte message, or 0 if
+ * chunk_len is 0.
+ */
+size_t gimli_aead_stream_len(size_t len, size_t chunk_len);
+
+/*
+ * Encrypt the chunks of a message starting at chunk first_chunk. The len bytes
+ * of m are written to c, with the tag of each chunk after it. If last is true,
+ * the range ends the stream, so its last chunk is flagged, and it may be
+ * shorter than chunk_len; otherwise len must be a multiple of chunk_len. To
+ * encrypt a whole stream, use first_chunk 0 and last true; c then has
+ * gimli_aead_stream_len(len, chunk_len) bytes. c must not overlap m.
+ *
+ * Returns false without writing anything if chunk_len is 0, the range is not
+ * made of whole chunks, or a chunk index would exceed 2^32 - 1.
+ */
+bool gimli_aead_stream_encrypt(unsigned char *c, const unsigned char *m,
+                               size_t len, size_t chunk_len,
+                               uint32_t first_chunk, bool last,
+                               const unsigned char
+                                   prefix[GIMLI_AEAD_STREAM_PREFIX_LEN],
+                               const unsigned char k[GIMLI_AEAD_KEY_LEN]);
+
+/*
+ * Decrypt the clen bytes of encrypted chunks in c, starting at chunk
+ * first_chunk, into m, which has room for the plaintext: clen less
+ * GIMLI_AEAD_TAG_DEFAULT_LEN bytes per chunk. If last is true, the range must
+ * end the stream. m must not overlap c.
+ *
+ * Returns false without writing anything if the range is not made of whole
+ * chunks, or if it does not end with a last chunk when last is true. Returns
+ * false and zeroes the plaintext if any chunk is not authentic.
+ */
+bool gimli_aead_stream_decrypt(unsigned char *m, const unsigned char *c,
+                               size_t clen, size_t chunk_len,
+                               uint32_t first_chunk, bool last,
+                               const unsigned char
+                                   prefix[GIMLI_AEAD_STREAM_PREFIX_LEN],
+                               const unsigned char k[GIMLI_AEAD_KEY_LEN]);
+
+#endif /* LITHIUM_GIMLI_AEAD_STREAM_H */
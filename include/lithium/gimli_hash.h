@@ -7,7 +7,9 @@
  */
 
 #include <lithium/gimli_state.h>
+#include <lithium/iovec.h>
 
+#include <stdbool.h>
 #include <stddef.h>
 
 /* cffi:begin */
@@ -20,11 +22,75 @@ void gimli_hash_init(gimli_hash_state *g);
 
 void gimli_hash_update(gimli_hash_state *g, const unsigned char *m, size_t len);
 
+/* Update with the concatenation of n fragments. */
+void gimli_hash_updatev(gimli_hash_state *g, const struct lith_iovec *iov,
+                        size_t n);
+
 void gimli_hash_final(gimli_hash_state *g, unsigned char *h, size_t len);
 
+/*
+ * Copy a hash state, so that messages sharing a prefix can be hashed by
+ * absorbing the prefix once and continuing from a clone for each message.
+ */
+void gimli_hash_clone(gimli_hash_state *dst, const gimli_hash_state *src);
+
 void gimli_hash(unsigned char *h, size_t hlen, const unsigned char *m,
                 size_t mlen);
 
+/*
+ * Use Gimli-Hash as an extendable output function. An XOF state is a finalized
+ * hash state and the number of bytes of its current output block already used.
+ * It is a separate type, so a state that is squeezing cannot be updated.
+ */
+typedef struct
+{
+    gimli_state g;
+    unsigned used;
+} gimli_xof_state;
+
+/* Finalize a copy of the hash state g for squeezing. g is not modified. */
+void gimli_xof_init(gimli_xof_state *x, const gimli_hash_state *g);
+
+/*
+ * Each call continues the output where the previous one left off, so the
+ * concatenated output is the same as one call to gimli_hash_final with the
+ * total length.
+ */
+void gimli_xof_squeeze(gimli_xof_state *x, unsigned char *out, size_t len);
+
+/*
+ * An XOF state is serialized like a gimli_state, with GIMLI_RATE plus the
+ * bytes used in place of the offset, so gimli_state_import rejects it and
+ * gimli_xof_import rejects an absorbing state.
+ */
+void gimli_xof_export(unsigned char out[GIMLI_STATE_EXPORT_LEN],
+                      const gimli_xof_state *x);
+
+/* Returns false and leaves x unchanged if in is not a valid exported state. */
+bool gimli_xof_import(gimli_xof_state *x,
+                      const unsigned char in[GIMLI_STATE_EXPORT_LEN]);
+
+/*
+ * Generate len bytes of counter mode output from a hash state that is still
+ * absorbing, without modifying it. Output block j is the rate of the padded
+ * state, with the little-endian 64-bit block index j xored into its first
+ * 8 bytes, after one permutation. Block 0 is the first block of the hash
+ * output. The output starts at block first_block, so a long output can be
+ * generated in pieces, and blocks are computed eight at a time with gimli_x8.
+ */
+void gimli_xof_ctr(const gimli_hash_state *g, unsigned char *out, size_t len,
+                   uint64_t first_block);
+
+/*
+ * Hash n independent messages, writing the hlen-byte digest of m[i], of length
+ * mlen[i], to h[i]. The results are the same as calling gimli_hash on each
+ * message, but messages are scheduled into the lanes of gimli_x8, and a lane
+ * is refilled with the next message as soon as its digest is written.
+ */
+void gimli_hash_many(unsigned char *const h[], size_t hlen,
+                     const unsigned char *const m[], const size_t mlen[],
+                     size_t n);
+
 /* cffi:end */
 
 #endif /* LITHIUM_GIMLI_HASH_H */
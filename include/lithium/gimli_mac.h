@@ -0,0 +1,50 @@
+#ifndef LITHIUM_GIMLI_MAC_H
+#define LITHIUM_GIMLI_MAC_H
+
+/*
+ * Part of liblithium, under the Apache License v2.0.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <lithium/gimli_state.h>
+
+#include <stddef.h>
+
+/*
+ * Keyed MAC: the tag of m under key is Gimli-Hash(key || m). The key fills two
+ * whole blocks, so gimli_mac_key_init absorbs it once into a key state, and
+ * each tag starts from a copy of that state without permuting the key again.
+ * The key state holds secret key material.
+ */
+
+/* cffi:begin */
+
+#define GIMLI_MAC_KEY_LEN 32
+#define GIMLI_MAC_DEFAULT_LEN 32
+
+typedef gimli_state gimli_mac_key;
+typedef gimli_state gimli_mac_state;
+
+void gimli_mac_key_init(gimli_mac_key *k,
+                        const unsigned char key[GIMLI_MAC_KEY_LEN]);
+
+void gimli_mac_init(gimli_mac_state *g, const gimli_mac_key *k);
+
+void gimli_mac_update(gimli_mac_state *g, const unsigned char *m, size_t len);
+
+void gimli_mac_final(gimli_mac_state *g, unsigned char *t, size_t len);
+
+void gimli_mac(unsigned char *t, size_t tlen, const unsigned char *m,
+               size_t mlen, const gimli_mac_key *k);
+
+/*
+ * Compute the tlen-byte tags of n independent messages, in the lanes of
+ * gimli_x8, as gimli_hash_many does.
+ */
+void gimli_mac_many(unsigned char *const t[], size_t tlen,
+                    const unsigned char *const m[], const size_t mlen[],
+                    size_t n, const gimli_mac_key *k);
+
+/* cffi:end */
+
+#endif /* LITHIUM_GIMLI_MAC_H */
@@ -8,6 +8,7 @@
 
 #include <lithium/gimli.h>
 
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 
@@ -19,6 +20,24 @@ typedef struct
     unsigned offset;
 } gimli_state;
 
+/*
+ * A serialized gimli_state is the state words in little-endian order followed
+ * by the offset, so it can be stored and resumed on any platform. This works
+ * for hash and AEAD states at any point. Squeezing XOF states have their own
+ * export and import, in gimli_hash.h.
+ */
+#define GIMLI_STATE_EXPORT_LEN 49
+
+void gimli_state_export(unsigned char out[GIMLI_STATE_EXPORT_LEN],
+                        const gimli_state *g);
+
+/*
+ * Returns false and leaves g unchanged if in is not a valid exported state,
+ * including if its offset is not below the rate.
+ */
+bool gimli_state_import(gimli_state *g,
+                        const unsigned char in[GIMLI_STATE_EXPORT_LEN]);
+
 /* cffi:end */
 
 #endif /* LITHIUM_GIMLI_STATE_H */
@@ -0,0 +1,79 @@
+#ifndef LITHIUM_GIMLI_TREE_HASH_H
+#define LITHIUM_GIMLI_TREE_HASH_H
+
+/*
+ * Part of liblithium, under the Apache License v2.0.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <lithium/gimli_hash.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Gimli tree hash: a two-level hash tree built on Gimli-Hash for large inputs.
+ *
+ * The message is split into leaves of GIMLI_TREE_HASH_LEAF_LEN bytes; only the
+ * last leaf may be shorter, and an empty message has one empty leaf. Each leaf
+ * is hashed independently to a chaining value:
+ *
+ *   cv_i = Gimli-Hash(leaf_i || 0x00)
+ *
+ * and the digest is computed from the chaining values in order:
+ *
+ *   h = Gimli-Hash(cv_0 || ... || cv_{n-1} || le64(n) || 0x01)
+ *
+ * gimli_tree_hash_update buffers up to GIMLI_TREE_HASH_BUF_LEN bytes, eight
+ * leaves, so that whole leaves are hashed in the lanes of the multi-lane
+ * permutation however the input is split across calls; gimli_tree_hash needs
+ * no buffer. To hash on several threads, each worker can compute chaining
+ * values for its own range of whole leaves with gimli_tree_hash_leaves, and
+ * then the chaining values are absorbed in order with
+ * gimli_tree_hash_update_cvs.
+ */
+
+/* cffi:begin */
+
+#define GIMLI_TREE_HASH_LEAF_LEN 8192
+#define GIMLI_TREE_HASH_CV_LEN 32
+#define GIMLI_TREE_HASH_BUF_LEN 65536
+
+typedef struct
+{
+    gimli_hash_state root;
+    uint64_t leaves;
+    size_t buf_len;
+    unsigned char buf[GIMLI_TREE_HASH_BUF_LEN];
+} gimli_tree_hash_state;
+
+void gimli_tree_hash_init(gimli_tree_hash_state *t);
+
+void gimli_tree_hash_update(gimli_tree_hash_state *t, const unsigned char *m,
+                            size_t len);
+
+void gimli_tree_hash_final(gimli_tree_hash_state *t, unsigned char *h,
+                           size_t len);
+
+void gimli_tree_hash(unsigned char *h, size_t hlen, const unsigned char *m,
+                     size_t mlen);
+
+/*
+ * Compute the chaining values of n whole leaves, reading
+ * n * GIMLI_TREE_HASH_LEAF_LEN bytes from m and writing
+ * n * GIMLI_TREE_HASH_CV_LEN bytes to cvs.
+ */
+void gimli_tree_hash_leaves(unsigned char *cvs, const unsigned char *m,
+                            size_t n);
+
+/*
+ * Absorb n chaining values produced by gimli_tree_hash_leaves as the next n
+ * leaves of the message. The message absorbed so far must be a whole number
+ * of leaves.
+ */
+void gimli_tree_hash_update_cvs(gimli_tree_hash_state *t,
+                                const unsigned char *cvs, size_t n);
+
+/* cffi:end */
+
+#endif /* LITHIUM_GIMLI_TREE_HASH_H */
@@ -0,0 +1,22 @@
+#ifndef LITHIUM_IOVEC_H
+#define LITHIUM_IOVEC_H
+
+/*
+ * Part of liblithium, under the Apache License v2.0.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stddef.h>
+
+/* cffi:begin */
+
+/* One fragment of a scatter-gather input. */
+struct lith_iovec
+{
+    const unsigned char *base;
+    size_t len;
+};
+
+/* cffi:end */
+
+#endif /* LITHIUM_IOVEC_H */
@@ -0,0 +1,100 @@
+#ifndef LITHIUM_MERKLE_H
+#define LITHIUM_MERKLE_H
+
+/*
+ * Part of liblithium, under the Apache License v2.0.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/*
+ * Binary Merkle tree over fixed-size chunks, built on Gimli-Hash.
+ *
+ * A message is split into n >= 1 chunks of chunk_len bytes, where only the
+ * last chunk may be shorter. The hashes are domain separated by a 16-byte
+ * prefix, which fills the first block of each hash:
+ *
+ *   leaf_i = Gimli-Hash("lith_merkle_leaf" || chunk_i)
+ *   node   = Gimli-Hash("lith_merkle_node" || left || right)
+ *   root   = Gimli-Hash("lith_merkle_root" || le64(n) || top)
+ *
+ * The leaves are padded to a power of two, P, and a node whose right subtree
+ * contains no chunks takes the value of its left child instead of hashing it.
+ *
+ * Nodes are stored in a flat array of lith_merkle_nodes(n) hashes, with the
+ * root at index 0, the top node at index 1, the children of node i at 2i and
+ * 2i + 1, and leaf i at P + i. Both children of a node are adjacent, so the
+ * interior nodes of each level are hashed in parallel lanes straight from the
+ * array.
+ */
+
+/* cffi:begin */
+
+#define LITH_MERKLE_HASH_LEN 32
+
+/* The maximum number of hashes in an inclusion proof. */
+#define LITH_MERKLE_MAX_PROOF_LEN 64
+
+typedef struct
+{
+    unsigned char *nodes;
+    size_t n;
+    size_t leaves;
+    size_t chunk_len;
+} lith_merkle_tree;
+
+/* The number of hashes of storage needed for a tree with n chunks. */
+size_t lith_merkle_nodes(size_t n);
+
+/*
+ * Set up a tree of n chunks using storage for lith_merkle_nodes(n) hashes at
+ * nodes.
+ */
+void lith_merkle_init(lith_merkle_tree *t, unsigned char *nodes, size_t n,
+                      size_t chunk_len);
+
+/*
+ * Hash the chunks starting at chunk index first from the len bytes at data,
+ * into their leaves. Only the leaves are written, so threads may hash disjoint
+ * ranges of chunks of the same tree at once, before calling lith_merkle_build.
+ * Returns false without writing anything if the chunks go past chunk n - 1.
+ */
+bool lith_merkle_hash_chunks(lith_merkle_tree *t, size_t first,
+                             const unsigned char *data, size_t len);
+
+/* Compute the interior nodes and the root from the leaves. */
+void lith_merkle_build(lith_merkle_tree *t);
+
+/*
+ * Replace chunk i and update the root, rehashing only the nodes on the path
+ * from its leaf to the root. Returns false without writing anything if
+ * i >= n.
+ */
+bool lith_merkle_update(lith_merkle_tree *t, size_t i,
+                        const unsigned char *chunk, size_t len);
+
+void lith_merkle_root(const lith_merkle_tree *t,
+                      unsigned char root[LITH_MERKLE_HASH_LEN]);
+
+/*
+ * Write the inclusion proof for chunk i, the hashes of the siblings on the path
+ * from its leaf to the top node, and return the number of hashes written.
+ * Returns 0 without writing anything if i >= n.
+ */
+size_t lith_merkle_proof(const lith_merkle_tree *t, size_t i,
+                         unsigned char *proof);
+
+/*
+ * Check that chunk i of a tree with n chunks and the given root is chunk,
+ * using a proof from lith_merkle_proof.
+ */
+bool lith_merkle_verify(const unsigned char root[LITH_MERKLE_HASH_LEN],
+                        size_t n, size_t i, const unsigned char *chunk,
+                        size_t len, const unsigned char *proof,
+                        size_t proof_len);
+
+/* cffi:end */
+
+#endif /* LITHIUM_MERKLE_H */
@@ -27,6 +27,9 @@ void lith_sign_init(lith_sign_state *state);
 void lith_sign_update(lith_sign_state *state, const unsigned char *msg,
                       size_t len);
 
+void lith_sign_updatev(lith_sign_state *state, const struct lith_iovec *iov,
+                       size_t n);
+
 void lith_sign_final_create(lith_sign_state *state,
                             unsigned char sig[LITH_SIGN_LEN],
                             const unsigned char
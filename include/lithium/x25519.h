@@ -11,6 +11,7 @@
  */
 
 #include <stdbool.h>
+#include <stddef.h>
 
 #define X25519_BITS 256
 #define X25519_LEN (X25519_BITS / 8)
@@ -24,6 +25,16 @@ void x25519(unsigned char out[X25519_LEN],
             const unsigned char scalar[X25519_LEN],
             const unsigned char point[X25519_LEN]);
 
+/*
+ * n independent x25519 scalar multiplications. Sets out[i] to
+ * scalar[i]*point[i], with the same results as calling x25519 on each. With
+ * AVX2 or AVX-512 IFMA, four or eight ladders run at once in vector lanes, and
+ * the results share field inversions.
+ */
+void x25519_batch(unsigned char *const out[],
+                  const unsigned char *const scalar[],
+                  const unsigned char *const point[], size_t n);
+
 /*
  * Scalar multiplication of the curve's base point.
  *
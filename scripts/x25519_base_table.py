@@ -0,0 +1,76 @@
+#!/usr/bin/env python3
+"""Generate src/x25519_base_table.h, the multiples of the base point used by
+the fixed-base comb in src/x25519_base.c.
+
+Entry [i][j] is (j + 1) * 256^i * B on the twisted Edwards curve birationally
+equivalent to Curve25519, as (y + x, y - x, 2dxy) mod p.
+"""
+
+import sys
+
+P = 2**255 - 19
+D = -121665 * pow(121666, -1, P) % P
+SQRT_M1 = pow(2, (P - 1) // 4, P)
+
+
+def recover_x(y):
+    xx = (y * y - 1) * pow(D * y * y + 1, -1, P) % P
+    x = pow(xx, (P + 3) // 8, P)
+    if (x * x - xx) % P != 0:
+        x = x * SQRT_M1 % P
+    assert (x * x - xx) % P == 0
+    return P - x if x % 2 else x
+
+
+def add(a, b):
+    (x1, y1), (x2, y2) = a, b
+    t = D * x1 * x2 * y1 * y2 % P
+    x3 = (x1 * y2 + y1 * x2) * pow(1 + t, -1, P) % P
+    y3 = (y1 * y2 + x1 * x2) * pow(1 - t, -1, P) % P
+    return x3, y3
+
+
+def fe(v):
+    words = [(v >> (64 * i)) & (2**64 - 1) for i in range(4)]
+    return "FE(0x%016X, 0x%016X,\n%s0x%016X, 0x%016X)" % (
+        words[0],
+        words[1],
+        " " * 15,
+        words[2],
+        words[3],
+    )
+
+
+def main():
+    y = 4 * pow(5, -1, P) % P
+    base = (recover_x(y), y)
+    # The base point maps to u = (1 + y)/(1 - y) = 9 on Curve25519.
+    assert (1 + y) * pow(1 - y, -1, P) % P == 9
+
+    out = sys.stdout
+    out.write(
+        "/*\n"
+        " * Part of liblithium, under the Apache License v2.0.\n"
+        " * SPDX-License-Identifier: Apache-2.0\n"
+        " */\n\n"
+        "/* Generated by scripts/x25519_base_table.py. Do not edit. */\n\n"
+        "static const niels base_table[32][8] = {\n"
+    )
+    for i in range(32):
+        out.write("    {\n")
+        point = base
+        for _ in range(8):
+            x, y = point
+            out.write("        {\n")
+            for v in ((y + x) % P, (y - x) % P, 2 * D * x * y % P):
+                out.write("            %s,\n" % fe(v))
+            out.write("        },\n")
+            point = add(point, base)
+        out.write("    },\n")
+        for _ in range(8):
+            base = add(base, base)
+    out.write("};\n")
+
+
+if __name__ == "__main__":
+    main()
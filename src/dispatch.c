@@ -0,0 +1,232 @@
+/*
+ * Part of liblithium, under the Apache License v2.0.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <lithium/dispatch.h>
+
+#include <lithium/gimli.h>
+#include <lithium/x25519.h>
+
+#include "dispatch.h"
+#include "fe.h"
+#include "gimli_common.h"
+#include "opt.h"
+
+#if !(LITH_DISPATCH)
+#error "dispatch.c is only used in builds with LITH_DISPATCH enabled"
+#endif
+
+#if !((defined(__x86_64__) || defined(__i386__)) &&                           \
+      (defined(__GNUC__) || defined(__clang__)))
+#error "runtime dispatch is only supported on x86 with gcc or clang"
+#endif
+
+#if !(LITH_SPONGE_WORDS)
+#error "runtime dispatch requires LITH_SPONGE_WORDS"
+#endif
+
+struct kernels
+{
+    void (*gimli)(uint32_t state[GIMLI_WORDS]);
+    void (*gimli_x4)(uint32_t states[4][GIMLI_WORDS]);
+    void (*gimli_x8)(uint32_t states[8][GIMLI_WORDS]);
+    void (*absorb_blocks)(uint32_t state[GIMLI_WORDS], const unsigned char *m,
+                          size_t nblocks);
+    void (*encrypt_blocks)(uint32_t state[GIMLI_WORDS], unsigned char *c,
+                           const unsigned char *m, size_t nblocks);
+    void (*decrypt_blocks)(uint32_t state[GIMLI_WORDS], unsigned char *m,
+                           const unsigned char *c, size_t nblocks);
+    void (*overwrite_blocks)(uint32_t state[GIMLI_WORDS],
+                             const unsigned char *c, size_t nblocks);
+    void (*squeeze_blocks)(uint32_t state[GIMLI_WORDS], unsigned char *h,
+                           size_t nblocks);
+    void (*mul)(fe out, const fe a, const fe b);
+    void (*mul_word)(fe out, const fe a, fe_limb b);
+    void (*x25519_batch)(unsigned char *const out[],
+                         const unsigned char *const scalar[],
+                         const unsigned char *const point[], size_t n);
+    bool (*ladder_lanes)(fe x2, fe z2, const unsigned char k[X25519_LEN],
+                         const fe x1);
+};
+
+#define DECLARE_KERNELS(level)                                                 \
+    void LITH_KERNEL_NAME(gimli, level)(uint32_t state[GIMLI_WORDS]);          \
+    void LITH_KERNEL_NAME(gimli_x4, level)(uint32_t states[4][GIMLI_WORDS]);   \
+    void LITH_KERNEL_NAME(gimli_x8, level)(uint32_t states[8][GIMLI_WORDS]);   \
+    void LITH_KERNEL_NAME(gimli_absorb_blocks, level)(                         \
+        uint32_t state[GIMLI_WORDS], const unsigned char *m, size_t nblocks);  \
+    void LITH_KERNEL_NAME(gimli_encrypt_blocks, level)(                        \
+        uint32_t state[GIMLI_WORDS], unsigned char *c, const unsigned char *m, \
+        size_t nblocks);                                                       \
+    void LITH_KERNEL_NAME(gimli_decrypt_blocks, level)(                        \
+        uint32_t state[GIMLI_WORDS], unsigned char *m, const unsigned char *c, \
+        size_t nblocks);                                                       \
+    void LITH_KERNEL_NAME(gimli_overwrite_blocks, level)(                      \
+        uint32_t state[GIMLI_WORDS], const unsigned char *c, size_t nblocks);  \
+    void LITH_KERNEL_NAME(gimli_squeeze_blocks, level)(                        \
+        uint32_t state[GIMLI_WORDS], unsigned char *h, size_t nblocks);        \
+    void LITH_KERNEL_NAME(mul, level)(fe out, const fe a, const fe b);         \
+    void LITH_KERNEL_NAME(mul_word, level)(fe out, const fe a, fe_limb b);     \
+    void LITH_KERNEL_NAME(x25519_batch, level)(                                \
+        unsigned char *const out[], const unsigned char *const scalar[],       \
+        const unsigned char *const point[], size_t n);                        \
+    bool LITH_KERNEL_NAME(ladder_lanes, level)(                                \
+        fe x2, fe z2, const unsigned char k[X25519_LEN], const fe x1)
+
+#define KERNELS(level)                                                         \
+    {                                                                          \
+        LITH_KERNEL_NAME(gimli, level), LITH_KERNEL_NAME(gimli_x4, level),     \
+            LITH_KERNEL_NAME(gimli_x8, level),                                 \
+            LITH_KERNEL_NAME(gimli_absorb_blocks, level),                      \
+            LITH_KERNEL_NAME(gimli_encrypt_blocks, level),                     \
+            LITH_KERNEL_NAME(gimli_decrypt_blocks, level),                     \
+            LITH_KERNEL_NAME(gimli_overwrite_blocks, level),                   \
+            LITH_KERNEL_NAME(gimli_squeeze_blocks, level),                     \
+            LITH_KERNEL_NAME(mul, level), LITH_KERNEL_NAME(mul_word, level),   \
+            LITH_KERNEL_NAME(x25519_batch, level),                             \
+            LITH_KERNEL_NAME(ladder_lanes, level),                             \
+    }
+
+DECLARE_KERNELS(scalar);
+DECLARE_KERNELS(sse2);
+DECLARE_KERNELS(ssse3);
+DECLARE_KERNELS(avx2);
+DECLARE_KERNELS(avx512);
+
+/* Indexed by LITH_LEVEL_*. */
+static const struct kernels levels[] = {
+    KERNELS(scalar), KERNELS(sse2),   KERNELS(ssse3),
+    KERNELS(avx2),   KERNELS(avx512),
+};
+
+static int supported_level(void)
+{
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") &&
+        __builtin_cpu_supports("avx512vl") && __builtin_cpu_supports("avx2") &&
+        __builtin_cpu_supports("bmi2"))
+    {
+        return LITH_LEVEL_AVX512;
+    }
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("bmi2"))
+    {
+        return LITH_LEVEL_AVX2;
+    }
+    if (__builtin_cpu_supports("ssse3"))
+    {
+        return LITH_LEVEL_SSSE3;
+    }
+    if (__builtin_cpu_supports("sse2"))
+    {
+        return LITH_LEVEL_SSE2;
+    }
+    return LITH_LEVEL_SCALAR;
+}
+
+/*
+ * The level is probed on first use. The bound table is published with a single
+ * atomic pointer store, and its level is its index in levels, so a reader
+ * always sees a level and kernels that belong together. Concurrent first
+ * calls probe the same level and store the same pointer.
+ */
+static const struct kernels *bound;
+
+int lith_dispatch_force(int level)
+{
+    const int supported = supported_level();
+    if (level > supported)
+    {
+        level = supported;
+    }
+    if (level < LITH_LEVEL_SCALAR)
+    {
+        level = LITH_LEVEL_SCALAR;
+    }
+    __atomic_store_n(&bound, &levels[level], __ATOMIC_RELEASE);
+    return level;
+}
+
+static const struct kernels *kernels(void)
+{
+    const struct kernels *k = __atomic_load_n(&bound, __ATOMIC_ACQUIRE);
+    if (k == NULL)
+    {
+        (void)lith_dispatch_force(LITH_LEVEL_AVX512);
+        k = __atomic_load_n(&bound, __ATOMIC_ACQUIRE);
+    }
+    return k;
+}
+
+int lith_dispatch_level(void)
+{
+    return (int)(kernels() - levels);
+}
+
+void gimli(uint32_t state[GIMLI_WORDS])
+{
+    kernels()->gimli(state);
+}
+
+void gimli_x4(uint32_t states[4][GIMLI_WORDS])
+{
+    kernels()->gimli_x4(states);
+}
+
+void gimli_x8(uint32_t states[8][GIMLI_WORDS])
+{
+    kernels()->gimli_x8(states);
+}
+
+void gimli_absorb_blocks(uint32_t state[GIMLI_WORDS], const unsigned char *m,
+                         size_t nblocks)
+{
+    kernels()->absorb_blocks(state, m, nblocks);
+}
+
+void gimli_encrypt_blocks(uint32_t state[GIMLI_WORDS], unsigned char *c,
+                          const unsigned char *m, size_t nblocks)
+{
+    kernels()->encrypt_blocks(state, c, m, nblocks);
+}
+
+void gimli_decrypt_blocks(uint32_t state[GIMLI_WORDS], unsigned char *m,
+                          const unsigned char *c, size_t nblocks)
+{
+    kernels()->decrypt_blocks(state, m, c, nblocks);
+}
+
+void gimli_overwrite_blocks(uint32_t state[GIMLI_WORDS],
+                            const unsigned char *c, size_t nblocks)
+{
+    kernels()->overwrite_blocks(state, c, nblocks);
+}
+
+void gimli_squeeze_blocks(uint32_t state[GIMLI_WORDS], unsigned char *h,
+                          size_t nblocks)
+{
+    kernels()->squeeze_blocks(state, h, nblocks);
+}
+
+void mul(fe out, const fe a, const fe b)
+{
+    kernels()->mul(out, a, b);
+}
+
+void mul_word(fe out, const fe a, fe_limb b)
+{
+    kernels()->mul_word(out, a, b);
+}
+
+void x25519_batch(unsigned char *const out[],
+                  const unsigned char *const scalar[],
+                  const unsigned char *const point[], size_t n)
+{
+    kernels()->x25519_batch(out, scalar, point, n);
+}
+
+bool ladder_lanes(fe x2, fe z2, const unsigned char k[X25519_LEN],
+                  const fe x1)
+{
+    return kernels()->ladder_lanes(x2, z2, k, x1);
+}
@@ -0,0 +1,26 @@
+#ifndef LITHIUM_DISPATCH_INTERNAL_H
+#define LITHIUM_DISPATCH_INTERNAL_H
+
+/*
+ * Part of liblithium, under the Apache License v2.0.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * With LITH_DISPATCH enabled, the Gimli permutations, the bulk sponge kernels,
+ * the field multiplication, and the vector ladders of x25519_batch and
+ * ladder_lanes are compiled once for each instruction set level by kernels.c,
+ * with LITH_KERNEL_LEVEL set to the level's name, and dispatch.c binds the
+ * best level supported by the running CPU.
+ *
+ * This header must not include any other headers, because kernels.c renames
+ * the kernels before their declarations are first seen.
+ */
+#ifndef LITH_DISPATCH
+#define LITH_DISPATCH 0
+#endif
+
+#define LITH_KERNEL_CAT(name, level) name##_##level
+#define LITH_KERNEL_NAME(name, level) LITH_KERNEL_CAT(name, level)
+
+#endif /* LITHIUM_DISPATCH_INTERNAL_H */
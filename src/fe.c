@@ -9,6 +9,8 @@
 
 #include "fe.h"
 
+#include "dispatch.h"
+
 #include <string.h>
 
 #define WLEN (LITH_X25519_WBITS / 8)
@@ -60,6 +62,18 @@ void write_limbs(unsigned char *out, const limb x[NLIMBS])
     }
 }
 
+#if (LITH_X25519_RADIX == 0)
+
+void fe_read(fe x, const unsigned char in[X25519_LEN])
+{
+    read_limbs(x, in);
+}
+
+void fe_write(unsigned char out[X25519_LEN], const fe x)
+{
+    write_limbs(out, x);
+}
+
 /*
  * Precondition: carry is small.
  * Invariant: result of propagate is < 2^255 + 1 word
@@ -103,6 +117,12 @@ void sub(fe out, const fe a, const fe b)
     propagate(out, (limb)(carry + 2));
 }
 
+/*
+ * With runtime dispatch, mul and mul_word are only compiled as kernels for each
+ * instruction set level, and the generic versions select one of those.
+ */
+#if !(LITH_DISPATCH) || defined(LITH_KERNEL_LEVEL)
+
 static void mul_n(fe out, const fe a, const limb *b, int nb)
 {
     limb accum[NLIMBS * 2] = {0};
@@ -128,26 +148,227 @@ static void mul_n(fe out, const fe a, const limb *b, int nb)
     propagate(out, carry);
 }
 
+#if (LITH_X25519_MULX)
+
+/*
+ * Multiply 4x64-bit a and b, and fold the high half of the product into the low
+ * half multiplied by 38, since 2^256 = 38 mod p. Each row of partial products
+ * adds its low words into the accumulator on the carry flag chain (ADCX) and
+ * its high words on the overflow flag chain (ADOX), so the two chains run in
+ * parallel. Returns the carry out of the folded result.
+ */
+static limb mul_mulx(fe out, const fe a, const fe b)
+{
+    limb z0, z1, z2, z3, z4, z5, z6, z7, lo, hi;
+    __asm__("movq 0(%[b]), %%rdx\n\t"
+            "mulxq 0(%[a]), %[z0], %[z1]\n\t"
+            "mulxq 8(%[a]), %[lo], %[z2]\n\t"
+            "addq %[lo], %[z1]\n\t"
+            "mulxq 16(%[a]), %[lo], %[z3]\n\t"
+            "adcq %[lo], %[z2]\n\t"
+            "mulxq 24(%[a]), %[lo], %[z4]\n\t"
+            "adcq %[lo], %[z3]\n\t"
+            "adcq $0, %[z4]\n\t"
+
+            "movq 8(%[b]), %%rdx\n\t"
+            "xorl %k[z5], %k[z5]\n\t"
+            "mulxq 0(%[a]), %[lo], %[hi]\n\t"
+            "adcxq %[lo], %[z1]\n\t"
+            "adoxq %[hi], %[z2]\n\t"
+            "mulxq 8(%[a]), %[lo], %[hi]\n\t"
+            "adcxq %[lo], %[z2]\n\t"
+            "adoxq %[hi], %[z3]\n\t"
+            "mulxq 16(%[a]), %[lo], %[hi]\n\t"
+            "adcxq %[lo], %[z3]\n\t"
+            "adoxq %[hi], %[z4]\n\t"
+            "mulxq 24(%[a]), %[lo], %[hi]\n\t"
+            "adcxq %[lo], %[z4]\n\t"
+            "adoxq %[hi], %[z5]\n\t"
+            "adcq $0, %[z5]\n\t"
+
+            "movq 16(%[b]), %%rdx\n\t"
+            "xorl %k[z6], %k[z6]\n\t"
+            "mulxq 0(%[a]), %[lo], %[hi]\n\t"
+            "adcxq %[lo], %[z2]\n\t"
+            "adoxq %[hi], %[z3]\n\t"
+            "mulxq 8(%[a]), %[lo], %[hi]\n\t"
+            "adcxq %[lo], %[z3]\n\t"
+            "adoxq %[hi], %[z4]\n\t"
+            "mulxq 16(%[a]), %[lo], %[hi]\n\t"
+            "adcxq %[lo], %[z4]\n\t"
+            "adoxq %[hi], %[z5]\n\t"
+            "mulxq 24(%[a]), %[lo], %[hi]\n\t"
+            "adcxq %[lo], %[z5]\n\t"
+            "adoxq %[hi], %[z6]\n\t"
+            "adcq $0, %[z6]\n\t"
+
+            "movq 24(%[b]), %%rdx\n\t"
+            "xorl %k[z7], %k[z7]\n\t"
+            "mulxq 0(%[a]), %[lo], %[hi]\n\t"
+            "adcxq %[lo], %[z3]\n\t"
+            "adoxq %[hi], %[z4]\n\t"
+            "mulxq 8(%[a]), %[lo], %[hi]\n\t"
+            "adcxq %[lo], %[z4]\n\t"
+            "adoxq %[hi], %[z5]\n\t"
+            "mulxq 16(%[a]), %[lo], %[hi]\n\t"
+            "adcxq %[lo], %[z5]\n\t"
+            "adoxq %[hi], %[z6]\n\t"
+            "mulxq 24(%[a]), %[lo], %[hi]\n\t"
+            "adcxq %[lo], %[z6]\n\t"
+            "adoxq %[hi], %[z7]\n\t"
+            "adcq $0, %[z7]\n\t"
+
+            "movl $38, %%edx\n\t"
+            "mulxq %[z4], %[lo], %[hi]\n\t"
+            "xorl %k[z4], %k[z4]\n\t"
+            "adcxq %[lo], %[z0]\n\t"
+            "adoxq %[hi], %[z1]\n\t"
+            "mulxq %[z5], %[lo], %[hi]\n\t"
+            "adcxq %[lo], %[z1]\n\t"
+            "adoxq %[hi], %[z2]\n\t"
+            "mulxq %[z6], %[lo], %[hi]\n\t"
+            "adcxq %[lo], %[z2]\n\t"
+            "adoxq %[hi], %[z3]\n\t"
+            "mulxq %[z7], %[lo], %[hi]\n\t"
+            "adcxq %[lo], %[z3]\n\t"
+            "adoxq %[hi], %[z4]\n\t"
+            "adcq $0, %[z4]"
+            : [z0] "=&r"(z0), [z1] "=&r"(z1), [z2] "=&r"(z2), [z3] "=&r"(z3),
+              [z4] "=&r"(z4), [z5] "=&r"(z5), [z6] "=&r"(z6), [z7] "=&r"(z7),
+              [lo] "=&r"(lo), [hi] "=&r"(hi)
+            : [a] "r"(a), [b] "r"(b)
+            : "rdx", "cc", "memory");
+    out[0] = z0;
+    out[1] = z1;
+    out[2] = z2;
+    out[3] = z3;
+    return z4;
+}
+
+void mul(fe out, const fe a, const fe b)
+{
+    propagate(out, mul_mulx(out, a, b));
+}
+
+#else
+
 void mul(fe out, const fe a, const fe b)
 {
     mul_n(out, a, b, NLIMBS);
 }
 
+#endif /* LITH_X25519_MULX */
+
 void mul_word(fe out, const fe a, limb b)
 {
     mul_n(out, a, &b, 1);
 }
 
+#endif /* !(LITH_DISPATCH) || defined(LITH_KERNEL_LEVEL) */
+
 void mul1(fe a, const fe b)
 {
     mul(a, b, a);
 }
 
+#if (LITH_X25519_MULX)
+
+/*
+ * Square 4x64-bit a with six cross products, which are doubled on the carry
+ * flag chain while the four squares are added on the overflow flag chain, and
+ * fold the result as in mul_mulx.
+ */
+static limb sqr_mulx(fe out, const fe a)
+{
+    limb z0, z1, z2, z3, z4, z5, z6, z7, lo, hi;
+    __asm__("movq 0(%[a]), %%rdx\n\t"
+            "mulxq 8(%[a]), %[z1], %[z2]\n\t"
+            "mulxq 16(%[a]), %[lo], %[z3]\n\t"
+            "addq %[lo], %[z2]\n\t"
+            "mulxq 24(%[a]), %[lo], %[z4]\n\t"
+            "adcq %[lo], %[z3]\n\t"
+            "adcq $0, %[z4]\n\t"
+
+            "movq 8(%[a]), %%rdx\n\t"
+            "xorl %k[z5], %k[z5]\n\t"
+            "mulxq 16(%[a]), %[lo], %[hi]\n\t"
+            "adcxq %[lo], %[z3]\n\t"
+            "adoxq %[hi], %[z4]\n\t"
+            "mulxq 24(%[a]), %[lo], %[hi]\n\t"
+            "adcxq %[lo], %[z4]\n\t"
+            "adoxq %[hi], %[z5]\n\t"
+            "adcq $0, %[z5]\n\t"
+
+            "movq 16(%[a]), %%rdx\n\t"
+            "mulxq 24(%[a]), %[lo], %[z6]\n\t"
+            "addq %[lo], %[z5]\n\t"
+            "adcq $0, %[z6]\n\t"
+
+            "movq 0(%[a]), %%rdx\n\t"
+            "xorl %k[z7], %k[z7]\n\t"
+            "mulxq %%rdx, %[z0], %[hi]\n\t"
+            "adcxq %[z1], %[z1]\n\t"
+            "adoxq %[hi], %[z1]\n\t"
+            "movq 8(%[a]), %%rdx\n\t"
+            "mulxq %%rdx, %[lo], %[hi]\n\t"
+            "adcxq %[z2], %[z2]\n\t"
+            "adoxq %[lo], %[z2]\n\t"
+            "adcxq %[z3], %[z3]\n\t"
+            "adoxq %[hi], %[z3]\n\t"
+            "movq 16(%[a]), %%rdx\n\t"
+            "mulxq %%rdx, %[lo], %[hi]\n\t"
+            "adcxq %[z4], %[z4]\n\t"
+            "adoxq %[lo], %[z4]\n\t"
+            "adcxq %[z5], %[z5]\n\t"
+            "adoxq %[hi], %[z5]\n\t"
+            "movq 24(%[a]), %%rdx\n\t"
+            "mulxq %%rdx, %[lo], %[hi]\n\t"
+            "adcxq %[z6], %[z6]\n\t"
+            "adoxq %[lo], %[z6]\n\t"
+            "adcxq %[z7], %[z7]\n\t"
+            "adoxq %[hi], %[z7]\n\t"
+
+            "movl $38, %%edx\n\t"
+            "mulxq %[z4], %[lo], %[hi]\n\t"
+            "xorl %k[z4], %k[z4]\n\t"
+            "adcxq %[lo], %[z0]\n\t"
+            "adoxq %[hi], %[z1]\n\t"
+            "mulxq %[z5], %[lo], %[hi]\n\t"
+            "adcxq %[lo], %[z1]\n\t"
+            "adoxq %[hi], %[z2]\n\t"
+            "mulxq %[z6], %[lo], %[hi]\n\t"
+            "adcxq %[lo], %[z2]\n\t"
+            "adoxq %[hi], %[z3]\n\t"
+            "mulxq %[z7], %[lo], %[hi]\n\t"
+            "adcxq %[lo], %[z3]\n\t"
+            "adoxq %[hi], %[z4]\n\t"
+            "adcq $0, %[z4]"
+            : [z0] "=&r"(z0), [z1] "=&r"(z1), [z2] "=&r"(z2), [z3] "=&r"(z3),
+              [z4] "=&r"(z4), [z5] "=&r"(z5), [z6] "=&r"(z6), [z7] "=&r"(z7),
+              [lo] "=&r"(lo), [hi] "=&r"(hi)
+            : [a] "r"(a)
+            : "rdx", "cc", "memory");
+    out[0] = z0;
+    out[1] = z1;
+    out[2] = z2;
+    out[3] = z3;
+    return z4;
+}
+
+void sqr1(fe a)
+{
+    propagate(a, sqr_mulx(a, a));
+}
+
+#else
+
 void sqr1(fe a)
 {
     mul1(a, a);
 }
 
+#endif /* LITH_X25519_MULX */
+
 limb canon(fe a)
 {
     /*
@@ -191,20 +412,99 @@ limb canon(fe a)
     return (limb)(((dlimb)res - 1) >> LITH_X25519_WBITS);
 }
 
+#endif /* LITH_X25519_RADIX == 0 */
+
+/*
+ * out = a^(2^n) * b
+ */
+static void sqrn_mul(fe out, const fe a, int n, const fe b)
+{
+    fe t;
+    int i;
+    (void)memcpy(t, a, sizeof(fe));
+    for (i = 0; i < n; ++i)
+    {
+        sqr1(t);
+    }
+    mul(out, t, b);
+}
+
+/*
+ * Raise a to p - 2 = 2^255 - 21 with an addition chain of 254 squarings and 11
+ * multiplications, where a_n denotes a^(2^n - 1).
+ */
 void inv(fe a)
 {
-    fe b;
+    fe a2, a9, a11, a_5, a_10, a_20, a_50, a_100, t;
+    (void)memcpy(a2, a, sizeof(fe));
+    sqr1(a2);                        /* a^2 */
+    sqrn_mul(a9, a2, 2, a);          /* a^9 */
+    mul(a11, a9, a2);                /* a^11 */
+    sqrn_mul(a_5, a11, 1, a9);       /* a^31 = a_5 */
+    sqrn_mul(a_10, a_5, 5, a_5);     /* a_10 */
+    sqrn_mul(a_20, a_10, 10, a_10);  /* a_20 */
+    sqrn_mul(t, a_20, 20, a_20);     /* a_40 */
+    sqrn_mul(a_50, t, 10, a_10);     /* a_50 */
+    sqrn_mul(a_100, a_50, 50, a_50); /* a_100 */
+    sqrn_mul(t, a_100, 100, a_100);  /* a_200 */
+    sqrn_mul(t, t, 50, a_50);        /* a_250 */
+    sqrn_mul(a, t, 5, a11);          /* a^(2^255 - 21) */
+}
+
+/*
+ * Copy a into t, replacing zero with one. Returns all ones if a is zero.
+ */
+static fe_limb load_nonzero(fe t, const fe a)
+{
+    fe_limb zero;
+    (void)memcpy(t, a, sizeof(fe));
+    zero = canon(t);
+    t[0] |= zero & 1U;
+    return zero;
+}
+
+static void clear_if(fe a, fe_limb mask)
+{
     int i;
-    (void)memcpy(b, a, sizeof(fe));
-    /* Raise to the p-2 = 0x7f..ffeb */
-    for (i = 253; i >= 0; --i)
+    for (i = 0; i < FE_LIMBS; ++i)
     {
-        sqr1(a);
-        if (i >= 8 || ((0xeb >> i) & 1))
-        {
-            mul1(a, b);
-        }
+        a[i] &= ~mask;
+    }
+}
+
+/*
+ * Invert n elements with one inversion and 3(n - 1) multiplications, by
+ * inverting the product of all of them. out[i] holds the product of in[0]
+ * through in[i] until the inverse of that product is known. Zero elements are
+ * replaced by one in the product, so each one only zeroes its own output.
+ */
+void fe_batch_inv(fe out[], const fe in[], size_t n)
+{
+    fe t, u;
+    fe_limb zero;
+    size_t i;
+    if (n == 0)
+    {
+        return;
+    }
+    (void)load_nonzero(out[0], in[0]);
+    for (i = 1; i < n; ++i)
+    {
+        (void)load_nonzero(t, in[i]);
+        mul(out[i], out[i - 1], t);
+    }
+    (void)memcpy(u, out[n - 1], sizeof(fe));
+    inv(u);
+    for (i = n - 1; i > 0; --i)
+    {
+        zero = load_nonzero(t, in[i]);
+        mul(out[i], u, out[i - 1]);
+        clear_if(out[i], zero);
+        mul1(u, t);
     }
+    zero = load_nonzero(t, in[0]);
+    (void)memcpy(out[0], u, sizeof(fe));
+    clear_if(out[0], zero);
 }
 
 /*
@@ -12,8 +12,27 @@
 
 #include <lithium/x25519.h>
 
+#include <limits.h>
+#include <stddef.h>
 #include <stdint.h>
 
+/*
+ * Field element representation. 0 uses NLIMBS saturated limbs of
+ * LITH_X25519_WBITS bits, with a carry propagated after every operation. 51
+ * uses five unsaturated 51-bit limbs in 64-bit words, and 25 uses ten
+ * unsaturated limbs of 26 and 25 bits in 32-bit words; both defer carries and
+ * have a dedicated squaring. The scalar arithmetic always uses saturated limbs.
+ * 25 is opt-in until it has been measured on a 32-bit target.
+ */
+#ifndef LITH_X25519_RADIX
+#if !defined(LITH_X25519_WBITS) && !defined(__OPTIMIZE_SIZE__) &&             \
+    defined(__GNUC__) && defined(__SIZEOF_INT128__)
+#define LITH_X25519_RADIX 51
+#else
+#define LITH_X25519_RADIX 0
+#endif
+#endif
+
 #ifndef LITH_X25519_WBITS
 #if defined(__GNUC__) && defined(__SIZEOF_INT128__)
 #define LITH_X25519_WBITS 64
@@ -57,14 +76,87 @@ typedef __int128_t sdlimb;
 
 #define NLIMBS (X25519_BITS / LITH_X25519_WBITS)
 
+/*
+ * On x86-64 with BMI2 and ADX, the saturated 64-bit field multiplication and
+ * squaring are done in assembly with MULX, which leaves the flags alone, and
+ * two independent carry chains through ADCX and ADOX.
+ */
+#if !defined(LITH_X25519_MULX) && (LITH_X25519_WBITS == 64) &&                 \
+    defined(__x86_64__) && defined(__GNUC__) && defined(__BMI2__) &&           \
+    defined(__ADX__)
+#define LITH_X25519_MULX 1
+#endif
+
+#ifndef LITH_X25519_MULX
+#define LITH_X25519_MULX 0
+#endif
+
+/*
+ * Fixed-base scalar multiplications use a signed comb over a table of 768
+ * precomputed field elements, 24 to 30 KiB depending on the representation,
+ * unless optimizing for size, where they run the ladder instead.
+ */
+#ifndef LITH_X25519_BASE_TABLE
+#if defined(__OPTIMIZE_SIZE__)
+#define LITH_X25519_BASE_TABLE 0
+#else
+#define LITH_X25519_BASE_TABLE 1
+#endif
+#endif
+
+/*
+ * Signature verification computes response times the base point in variable
+ * time from the same table, instead of with a second ladder.
+ */
+#ifndef LITH_X25519_FAST_VERIFY
+#define LITH_X25519_FAST_VERIFY LITH_X25519_BASE_TABLE
+#endif
+
+#if (LITH_X25519_FAST_VERIFY) && !(LITH_X25519_BASE_TABLE)
+#error "LITH_X25519_FAST_VERIFY requires LITH_X25519_BASE_TABLE"
+#endif
+
 #define LIMB_HIGH_BIT_MASK ((limb)1U << (LITH_X25519_WBITS - 1))
 
-typedef limb fe[NLIMBS];
+#if (LITH_X25519_RADIX == 0)
+
+typedef limb fe_limb;
+#define FE_LIMBS NLIMBS
+#define FE_HIGH_BIT_MASK LIMB_HIGH_BIT_MASK
+
+#elif (LITH_X25519_RADIX == 51)
+
+#if !defined(__SIZEOF_INT128__)
+#error "LITH_X25519_RADIX 51 requires a 128-bit integer type"
+#endif
+
+typedef uint64_t fe_limb;
+#define FE_LIMBS 5
+/* fe_read leaves bit 255 of the input in the top limb. */
+#define FE_HIGH_BIT_MASK (UINT64_C(1) << 51)
+
+#elif (LITH_X25519_RADIX == 25)
+
+typedef uint32_t fe_limb;
+#define FE_LIMBS 10
+/* fe_read leaves bit 255 of the input in the top limb. */
+#define FE_HIGH_BIT_MASK (UINT32_C(1) << 25)
+
+#else
+#error "LITH_X25519_RADIX must be 0, 25, or 51"
+#endif
+
+typedef fe_limb fe[FE_LIMBS];
 
 void read_limbs(limb x[NLIMBS], const unsigned char *in);
 
 void write_limbs(unsigned char *out, const limb x[NLIMBS]);
 
+void fe_read(fe x, const unsigned char in[X25519_LEN]);
+
+/* Precondition: x is canonical. */
+void fe_write(unsigned char out[X25519_LEN], const fe x);
+
 void add(fe out, const fe a, const fe b);
 
 void sub(fe out, const fe a, const fe b);
@@ -73,14 +165,46 @@ void mul(fe out, const fe a, const fe b);
 
 void mul1(fe a, const fe b);
 
-void mul_word(fe out, const fe a, limb b);
+void mul_word(fe out, const fe a, fe_limb b);
 
 void sqr1(fe a);
 
-limb canon(fe a);
+fe_limb canon(fe a);
 
 void inv(fe a);
 
+/*
+ * Set out[i] to the inverse of in[i], or to zero if in[i] is zero. out and in
+ * must not overlap.
+ */
+void fe_batch_inv(fe out[], const fe in[], size_t n);
+
+/*
+ * Copy an X25519 scalar to k, clamped as RFC7748 section 5 describes.
+ */
+void clamp(unsigned char k[X25519_LEN], const unsigned char scalar[X25519_LEN]);
+
+/*
+ * Set x2 and z2 to the projective result of the Montgomery ladder of x25519_q,
+ * with the independent field operations of each step run side by side in
+ * vector lanes. Returns false, leaving x2 and z2 unchanged, when there are no
+ * vector lanes to run it in.
+ */
+bool ladder_lanes(fe x2, fe z2, const unsigned char k[X25519_LEN],
+                  const fe x1);
+
+/*
+ * Set u and w so that u/w is the Montgomery x-coordinate of k times the base
+ * point, for k below L, from a table of multiples of the base point. Only
+ * present if LITH_X25519_BASE_TABLE is enabled.
+ */
+void base_mul(fe u, fe w, const unsigned char k[X25519_LEN]);
+
+/*
+ * base_mul for a public k, in variable time.
+ */
+void base_mul_vartime(fe u, fe w, const unsigned char k[X25519_LEN]);
+
 sdlimb asr(sdlimb x, int b);
 
 limb mac(limb *carry, limb a, limb b, limb c);
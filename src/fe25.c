@@ -0,0 +1,311 @@
+/*
+ * Part of liblithium, under the Apache License v2.0.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Field arithmetic mod 2^255 - 19 with ten unsaturated limbs in radix 2^25.5,
+ * used when LITH_X25519_RADIX is 25. Even limbs hold 26 bits and odd limbs hold
+ * 25, so limb i has weight 2^ceil(25.5i), and a product of two odd limbs is
+ * doubled to land on the right weight. Limbs may exceed their width between
+ * operations:
+ *
+ * - mul, mul_word, sqr1, and sub carry their outputs to limbs below
+ *   2^26 + 2^18.
+ * - add does not carry, so its outputs are below 2^27 + 2^19.
+ * - Inputs of mul, mul_word, and sqr1 may have limbs up to 2^27 + 2^20, and
+ *   inputs of sub may have odd limbs up to 2^27 - 4 and even limbs up to
+ *   2^28 - 4.
+ *
+ * Products are accumulated in 64 bits, and columns at or above 2^255 wrap
+ * around multiplied by 19.
+ */
+
+#include "fe.h"
+
+#include "dispatch.h"
+
+#if (LITH_X25519_RADIX == 25)
+
+#define MASK26 ((UINT32_C(1) << 26) - 1)
+#define MASK25 ((UINT32_C(1) << 25) - 1)
+
+static unsigned width(int i)
+{
+    return (i & 1) ? 25 : 26;
+}
+
+static unsigned offset(int i)
+{
+    return (unsigned)((i * 51 + 1) / 2);
+}
+
+void fe_read(fe x, const unsigned char in[X25519_LEN])
+{
+    uint32_t w[X25519_LEN / 4];
+    int i;
+    for (i = 0; i < X25519_LEN / 4; ++i)
+    {
+        w[i] = (uint32_t)in[i * 4] | (uint32_t)in[i * 4 + 1] << 8 |
+               (uint32_t)in[i * 4 + 2] << 16 | (uint32_t)in[i * 4 + 3] << 24;
+    }
+    for (i = 0; i < FE_LIMBS; ++i)
+    {
+        const unsigned off = offset(i), sh = off % 32;
+        uint32_t v = w[off / 32] >> sh;
+        if (sh + width(i) > 32)
+        {
+            v |= w[off / 32 + 1] << (32 - sh);
+        }
+        x[i] = v & ((i & 1) ? MASK25 : MASK26);
+    }
+    /* Keep bit 255 in the top limb. */
+    x[FE_LIMBS - 1] = w[X25519_LEN / 4 - 1] >> 6;
+}
+
+void fe_write(unsigned char out[X25519_LEN], const fe x)
+{
+    uint32_t w[X25519_LEN / 4] = {0};
+    int i;
+    for (i = 0; i < FE_LIMBS; ++i)
+    {
+        const unsigned off = offset(i), sh = off % 32;
+        w[off / 32] |= x[i] << sh;
+        if (sh + width(i) > 32)
+        {
+            w[off / 32 + 1] |= x[i] >> (32 - sh);
+        }
+    }
+    for (i = 0; i < X25519_LEN / 4; ++i)
+    {
+        out[i * 4] = (unsigned char)(w[i] & 0xFFU);
+        out[i * 4 + 1] = (unsigned char)((w[i] >> 8) & 0xFFU);
+        out[i * 4 + 2] = (unsigned char)((w[i] >> 16) & 0xFFU);
+        out[i * 4 + 3] = (unsigned char)((w[i] >> 24) & 0xFFU);
+    }
+}
+
+/*
+ * Carry 64-bit column sums into out, in two interleaved chains, 0 to 5 and 5 to
+ * 0, to shorten the dependency path. The output limbs are within their width,
+ * except limbs 1 and 6, which may be up to 2^25 + 2^13.
+ */
+static void carry_wide(fe out, uint64_t r[FE_LIMBS])
+{
+    r[1] += r[0] >> 26;
+    r[6] += r[5] >> 25;
+    r[2] += r[1] >> 25;
+    r[7] += r[6] >> 26;
+    r[3] += r[2] >> 26;
+    r[8] += r[7] >> 25;
+    r[4] += r[3] >> 25;
+    r[9] += r[8] >> 26;
+    r[5] = (r[5] & MASK25) + (r[4] >> 26);
+    r[0] = (r[0] & MASK26) + (r[9] >> 25) * 19;
+    r[6] = (r[6] & MASK26) + (r[5] >> 25);
+    r[1] = (r[1] & MASK25) + (r[0] >> 26);
+    out[0] = (uint32_t)r[0] & MASK26;
+    out[1] = (uint32_t)r[1];
+    out[2] = (uint32_t)r[2] & MASK26;
+    out[3] = (uint32_t)r[3] & MASK25;
+    out[4] = (uint32_t)r[4] & MASK26;
+    out[5] = (uint32_t)r[5] & MASK25;
+    out[6] = (uint32_t)r[6];
+    out[7] = (uint32_t)r[7] & MASK25;
+    out[8] = (uint32_t)r[8] & MASK26;
+    out[9] = (uint32_t)r[9] & MASK25;
+}
+
+static void carry(fe x)
+{
+    uint64_t r[FE_LIMBS];
+    int i;
+    for (i = 0; i < FE_LIMBS; ++i)
+    {
+        r[i] = x[i];
+    }
+    carry_wide(x, r);
+}
+
+void add(fe out, const fe a, const fe b)
+{
+    int i;
+    for (i = 0; i < FE_LIMBS; ++i)
+    {
+        out[i] = a[i] + b[i];
+    }
+}
+
+void sub(fe out, const fe a, const fe b)
+{
+    /* Add 4p so no limb goes negative. */
+    int i;
+    out[0] = a[0] + UINT32_C(0xFFFFFB4) - b[0];
+    for (i = 1; i < FE_LIMBS; ++i)
+    {
+        out[i] = a[i] + ((i & 1) ? UINT32_C(0x7FFFFFC) : UINT32_C(0xFFFFFFC)) -
+                 b[i];
+    }
+    carry(out);
+}
+
+/*
+ * With runtime dispatch, mul and mul_word are only compiled as kernels for each
+ * instruction set level, and the generic versions select one of those.
+ */
+#if !(LITH_DISPATCH) || defined(LITH_KERNEL_LEVEL)
+
+void mul(fe out, const fe a, const fe b)
+{
+    const uint32_t a0 = a[0], a1 = a[1], a2 = a[2], a3 = a[3], a4 = a[4],
+                   a5 = a[5], a6 = a[6], a7 = a[7], a8 = a[8], a9 = a[9];
+    const uint32_t b0 = b[0], b1 = b[1], b2 = b[2], b3 = b[3], b4 = b[4],
+                   b5 = b[5], b6 = b[6], b7 = b[7], b8 = b[8], b9 = b[9];
+    const uint32_t a1_2 = a1 * 2, a3_2 = a3 * 2, a5_2 = a5 * 2, a7_2 = a7 * 2,
+                   a9_2 = a9 * 2;
+    const uint32_t b1_19 = b1 * 19, b2_19 = b2 * 19, b3_19 = b3 * 19,
+                   b4_19 = b4 * 19, b5_19 = b5 * 19, b6_19 = b6 * 19,
+                   b7_19 = b7 * 19, b8_19 = b8 * 19, b9_19 = b9 * 19;
+    uint64_t r[FE_LIMBS];
+    r[0] = (uint64_t)a0 * b0 + (uint64_t)a1_2 * b9_19 + (uint64_t)a2 * b8_19 +
+           (uint64_t)a3_2 * b7_19 + (uint64_t)a4 * b6_19 +
+           (uint64_t)a5_2 * b5_19 + (uint64_t)a6 * b4_19 +
+           (uint64_t)a7_2 * b3_19 + (uint64_t)a8 * b2_19 +
+           (uint64_t)a9_2 * b1_19;
+    r[1] = (uint64_t)a0 * b1 + (uint64_t)a1 * b0 + (uint64_t)a2 * b9_19 +
+           (uint64_t)a3 * b8_19 + (uint64_t)a4 * b7_19 + (uint64_t)a5 * b6_19 +
+           (uint64_t)a6 * b5_19 + (uint64_t)a7 * b4_19 + (uint64_t)a8 * b3_19 +
+           (uint64_t)a9 * b2_19;
+    r[2] = (uint64_t)a0 * b2 + (uint64_t)a1_2 * b1 + (uint64_t)a2 * b0 +
+           (uint64_t)a3_2 * b9_19 + (uint64_t)a4 * b8_19 +
+           (uint64_t)a5_2 * b7_19 + (uint64_t)a6 * b6_19 +
+           (uint64_t)a7_2 * b5_19 + (uint64_t)a8 * b4_19 +
+           (uint64_t)a9_2 * b3_19;
+    r[3] = (uint64_t)a0 * b3 + (uint64_t)a1 * b2 + (uint64_t)a2 * b1 +
+           (uint64_t)a3 * b0 + (uint64_t)a4 * b9_19 + (uint64_t)a5 * b8_19 +
+           (uint64_t)a6 * b7_19 + (uint64_t)a7 * b6_19 + (uint64_t)a8 * b5_19 +
+           (uint64_t)a9 * b4_19;
+    r[4] = (uint64_t)a0 * b4 + (uint64_t)a1_2 * b3 + (uint64_t)a2 * b2 +
+           (uint64_t)a3_2 * b1 + (uint64_t)a4 * b0 + (uint64_t)a5_2 * b9_19 +
+           (uint64_t)a6 * b8_19 + (uint64_t)a7_2 * b7_19 +
+           (uint64_t)a8 * b6_19 + (uint64_t)a9_2 * b5_19;
+    r[5] = (uint64_t)a0 * b5 + (uint64_t)a1 * b4 + (uint64_t)a2 * b3 +
+           (uint64_t)a3 * b2 + (uint64_t)a4 * b1 + (uint64_t)a5 * b0 +
+           (uint64_t)a6 * b9_19 + (uint64_t)a7 * b8_19 + (uint64_t)a8 * b7_19 +
+           (uint64_t)a9 * b6_19;
+    r[6] = (uint64_t)a0 * b6 + (uint64_t)a1_2 * b5 + (uint64_t)a2 * b4 +
+           (uint64_t)a3_2 * b3 + (uint64_t)a4 * b2 + (uint64_t)a5_2 * b1 +
+           (uint64_t)a6 * b0 + (uint64_t)a7_2 * b9_19 + (uint64_t)a8 * b8_19 +
+           (uint64_t)a9_2 * b7_19;
+    r[7] = (uint64_t)a0 * b7 + (uint64_t)a1 * b6 + (uint64_t)a2 * b5 +
+           (uint64_t)a3 * b4 + (uint64_t)a4 * b3 + (uint64_t)a5 * b2 +
+           (uint64_t)a6 * b1 + (uint64_t)a7 * b0 + (uint64_t)a8 * b9_19 +
+           (uint64_t)a9 * b8_19;
+    r[8] = (uint64_t)a0 * b8 + (uint64_t)a1_2 * b7 + (uint64_t)a2 * b6 +
+           (uint64_t)a3_2 * b5 + (uint64_t)a4 * b4 + (uint64_t)a5_2 * b3 +
+           (uint64_t)a6 * b2 + (uint64_t)a7_2 * b1 + (uint64_t)a8 * b0 +
+           (uint64_t)a9_2 * b9_19;
+    r[9] = (uint64_t)a0 * b9 + (uint64_t)a1 * b8 + (uint64_t)a2 * b7 +
+           (uint64_t)a3 * b6 + (uint64_t)a4 * b5 + (uint64_t)a5 * b4 +
+           (uint64_t)a6 * b3 + (uint64_t)a7 * b2 + (uint64_t)a8 * b1 +
+           (uint64_t)a9 * b0;
+    carry_wide(out, r);
+}
+
+void mul_word(fe out, const fe a, fe_limb b)
+{
+    uint64_t r[FE_LIMBS];
+    int i;
+    for (i = 0; i < FE_LIMBS; ++i)
+    {
+        r[i] = (uint64_t)a[i] * b;
+    }
+    carry_wide(out, r);
+}
+
+#endif /* !(LITH_DISPATCH) || defined(LITH_KERNEL_LEVEL) */
+
+void mul1(fe a, const fe b)
+{
+    mul(a, b, a);
+}
+
+/*
+ * Squaring needs 55 limb products instead of the 100 of mul, because each
+ * cross product appears twice.
+ */
+void sqr1(fe a)
+{
+    const uint32_t a0 = a[0], a1 = a[1], a2 = a[2], a3 = a[3], a4 = a[4],
+                   a5 = a[5], a6 = a[6], a7 = a[7], a8 = a[8], a9 = a[9];
+    const uint32_t a0_2 = a0 * 2, a1_2 = a1 * 2, a2_2 = a2 * 2, a3_2 = a3 * 2,
+                   a4_2 = a4 * 2, a5_2 = a5 * 2, a6_2 = a6 * 2, a7_2 = a7 * 2,
+                   a8_2 = a8 * 2, a9_2 = a9 * 2;
+    const uint32_t a1_4 = a1 * 4, a3_4 = a3 * 4, a5_4 = a5 * 4, a7_4 = a7 * 4;
+    const uint32_t a5_19 = a5 * 19, a6_19 = a6 * 19, a7_19 = a7 * 19,
+                   a8_19 = a8 * 19, a9_19 = a9 * 19;
+    uint64_t r[FE_LIMBS];
+    r[0] = (uint64_t)a0 * a0 + (uint64_t)a1_4 * a9_19 + (uint64_t)a2_2 * a8_19 +
+           (uint64_t)a3_4 * a7_19 + (uint64_t)a4_2 * a6_19 +
+           (uint64_t)a5_2 * a5_19;
+    r[1] = (uint64_t)a0_2 * a1 + (uint64_t)a2_2 * a9_19 +
+           (uint64_t)a3_2 * a8_19 + (uint64_t)a4_2 * a7_19 +
+           (uint64_t)a5_2 * a6_19;
+    r[2] = (uint64_t)a0_2 * a2 + (uint64_t)a1_2 * a1 + (uint64_t)a3_4 * a9_19 +
+           (uint64_t)a4_2 * a8_19 + (uint64_t)a5_4 * a7_19 +
+           (uint64_t)a6 * a6_19;
+    r[3] = (uint64_t)a0_2 * a3 + (uint64_t)a1_2 * a2 + (uint64_t)a4_2 * a9_19 +
+           (uint64_t)a5_2 * a8_19 + (uint64_t)a6_2 * a7_19;
+    r[4] = (uint64_t)a0_2 * a4 + (uint64_t)a1_4 * a3 + (uint64_t)a2 * a2 +
+           (uint64_t)a5_4 * a9_19 + (uint64_t)a6_2 * a8_19 +
+           (uint64_t)a7_2 * a7_19;
+    r[5] = (uint64_t)a0_2 * a5 + (uint64_t)a1_2 * a4 + (uint64_t)a2_2 * a3 +
+           (uint64_t)a6_2 * a9_19 + (uint64_t)a7_2 * a8_19;
+    r[6] = (uint64_t)a0_2 * a6 + (uint64_t)a1_4 * a5 + (uint64_t)a2_2 * a4 +
+           (uint64_t)a3_2 * a3 + (uint64_t)a7_4 * a9_19 + (uint64_t)a8 * a8_19;
+    r[7] = (uint64_t)a0_2 * a7 + (uint64_t)a1_2 * a6 + (uint64_t)a2_2 * a5 +
+           (uint64_t)a3_2 * a4 + (uint64_t)a8_2 * a9_19;
+    r[8] = (uint64_t)a0_2 * a8 + (uint64_t)a1_4 * a7 + (uint64_t)a2_2 * a6 +
+           (uint64_t)a3_4 * a5 + (uint64_t)a4 * a4 + (uint64_t)a9_2 * a9_19;
+    r[9] = (uint64_t)a0_2 * a9 + (uint64_t)a1_2 * a8 + (uint64_t)a2_2 * a7 +
+           (uint64_t)a3_2 * a6 + (uint64_t)a4_2 * a5;
+    carry_wide(a, r);
+}
+
+fe_limb canon(fe a)
+{
+    /*
+     * Canonicalize a field element a, reducing it to the least residue which
+     * is congruent to it mod 2^255-19. Returns 0 if the residue is nonzero.
+     */
+    uint32_t q, res = 0;
+    int i;
+
+    /* After two carries, a < 2p, so a + 19 < 2^256. */
+    carry(a);
+    carry(a);
+
+    /* q = 1 if a >= p, which is when a + 19 carries out of bit 255. */
+    q = (a[0] + 19) >> 26;
+    for (i = 1; i < FE_LIMBS; ++i)
+    {
+        q = (a[i] + q) >> width(i);
+    }
+
+    /* Subtract qp by adding 19q and dropping bit 255. */
+    a[0] += q * 19;
+    for (i = 0; i < FE_LIMBS - 1; ++i)
+    {
+        a[i + 1] += a[i] >> width(i);
+        a[i] &= (i & 1) ? MASK25 : MASK26;
+    }
+    a[FE_LIMBS - 1] &= MASK25;
+
+    for (i = 0; i < FE_LIMBS; ++i)
+    {
+        res |= a[i];
+    }
+    return (fe_limb)(((uint64_t)res - 1) >> 32);
+}
+
+#endif /* LITH_X25519_RADIX == 25 */
@@ -0,0 +1,220 @@
+/*
+ * Part of liblithium, under the Apache License v2.0.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Field arithmetic mod 2^255 - 19 with five unsaturated 51-bit limbs, used when
+ * LITH_X25519_RADIX is 51. Limb i has weight 2^(51i), and limbs may exceed 51
+ * bits between operations:
+ *
+ * - mul, mul_word, sqr1, and sub carry their outputs to limbs below 2^52.
+ * - add does not carry, so its outputs are below 2^53.
+ * - Inputs of mul, mul_word, and sqr1 may have limbs up to 2^54, and inputs of
+ *   sub may have limbs up to 2^53 - 76.
+ *
+ * Products are accumulated in 128 bits, and the carry from the top limb wraps
+ * around to the bottom one multiplied by 19, because 2^255 = 19 mod p.
+ */
+
+#include "fe.h"
+
+#include "dispatch.h"
+
+#if (LITH_X25519_RADIX == 51)
+
+typedef __uint128_t wide;
+
+#define MASK51 ((UINT64_C(1) << 51) - 1)
+
+static uint64_t load64(const unsigned char *p)
+{
+    return (uint64_t)p[0] | (uint64_t)p[1] << 8 | (uint64_t)p[2] << 16 |
+           (uint64_t)p[3] << 24 | (uint64_t)p[4] << 32 | (uint64_t)p[5] << 40 |
+           (uint64_t)p[6] << 48 | (uint64_t)p[7] << 56;
+}
+
+static void store64(unsigned char *p, uint64_t x)
+{
+    int i;
+    for (i = 0; i < 8; ++i)
+    {
+        p[i] = (unsigned char)(x & 0xFFU);
+        x >>= 8;
+    }
+}
+
+void fe_read(fe x, const unsigned char in[X25519_LEN])
+{
+    const uint64_t w0 = load64(&in[0]), w1 = load64(&in[8]),
+                   w2 = load64(&in[16]), w3 = load64(&in[24]);
+    x[0] = w0 & MASK51;
+    x[1] = ((w0 >> 51) | (w1 << 13)) & MASK51;
+    x[2] = ((w1 >> 38) | (w2 << 26)) & MASK51;
+    x[3] = ((w2 >> 25) | (w3 << 39)) & MASK51;
+    x[4] = w3 >> 12;
+}
+
+void fe_write(unsigned char out[X25519_LEN], const fe x)
+{
+    store64(&out[0], x[0] | (x[1] << 51));
+    store64(&out[8], (x[1] >> 13) | (x[2] << 38));
+    store64(&out[16], (x[2] >> 26) | (x[3] << 25));
+    store64(&out[24], (x[3] >> 39) | (x[4] << 12));
+}
+
+/*
+ * Carry every limb into the next one. The output limbs are below 2^51, except
+ * limb 0, which is below 2^51 + 19 * 2^13.
+ */
+static void carry(fe x)
+{
+    uint64_t c;
+    c = x[0] >> 51;
+    x[0] &= MASK51;
+    x[1] += c;
+    c = x[1] >> 51;
+    x[1] &= MASK51;
+    x[2] += c;
+    c = x[2] >> 51;
+    x[2] &= MASK51;
+    x[3] += c;
+    c = x[3] >> 51;
+    x[3] &= MASK51;
+    x[4] += c;
+    c = x[4] >> 51;
+    x[4] &= MASK51;
+    x[0] += c * 19;
+}
+
+/*
+ * Carry the 128-bit column sums of a product into out.
+ */
+static void carry_wide(fe out, wide r0, wide r1, wide r2, wide r3, wide r4)
+{
+    wide c;
+    r1 += r0 >> 51;
+    r2 += r1 >> 51;
+    r3 += r2 >> 51;
+    r4 += r3 >> 51;
+    c = (wide)((uint64_t)r0 & MASK51) + (r4 >> 51) * 19;
+    out[0] = (uint64_t)c & MASK51;
+    out[1] = ((uint64_t)r1 & MASK51) + (uint64_t)(c >> 51);
+    out[2] = (uint64_t)r2 & MASK51;
+    out[3] = (uint64_t)r3 & MASK51;
+    out[4] = (uint64_t)r4 & MASK51;
+}
+
+void add(fe out, const fe a, const fe b)
+{
+    int i;
+    for (i = 0; i < FE_LIMBS; ++i)
+    {
+        out[i] = a[i] + b[i];
+    }
+}
+
+void sub(fe out, const fe a, const fe b)
+{
+    /* Add 4p so no limb goes negative. */
+    out[0] = a[0] + UINT64_C(0x1FFFFFFFFFFFB4) - b[0];
+    out[1] = a[1] + UINT64_C(0x1FFFFFFFFFFFFC) - b[1];
+    out[2] = a[2] + UINT64_C(0x1FFFFFFFFFFFFC) - b[2];
+    out[3] = a[3] + UINT64_C(0x1FFFFFFFFFFFFC) - b[3];
+    out[4] = a[4] + UINT64_C(0x1FFFFFFFFFFFFC) - b[4];
+    carry(out);
+}
+
+/*
+ * With runtime dispatch, mul and mul_word are only compiled as kernels for each
+ * instruction set level, and the generic versions select one of those.
+ */
+#if !(LITH_DISPATCH) || defined(LITH_KERNEL_LEVEL)
+
+void mul(fe out, const fe a, const fe b)
+{
+    const uint64_t b1_19 = b[1] * 19, b2_19 = b[2] * 19, b3_19 = b[3] * 19,
+                   b4_19 = b[4] * 19;
+    const wide r0 = (wide)a[0] * b[0] + (wide)a[1] * b4_19 +
+                    (wide)a[2] * b3_19 + (wide)a[3] * b2_19 +
+                    (wide)a[4] * b1_19;
+    const wide r1 = (wide)a[0] * b[1] + (wide)a[1] * b[0] +
+                    (wide)a[2] * b4_19 + (wide)a[3] * b3_19 +
+                    (wide)a[4] * b2_19;
+    const wide r2 = (wide)a[0] * b[2] + (wide)a[1] * b[1] +
+                    (wide)a[2] * b[0] + (wide)a[3] * b4_19 +
+                    (wide)a[4] * b3_19;
+    const wide r3 = (wide)a[0] * b[3] + (wide)a[1] * b[2] +
+                    (wide)a[2] * b[1] + (wide)a[3] * b[0] +
+                    (wide)a[4] * b4_19;
+    const wide r4 = (wide)a[0] * b[4] + (wide)a[1] * b[3] +
+                    (wide)a[2] * b[2] + (wide)a[3] * b[1] + (wide)a[4] * b[0];
+    carry_wide(out, r0, r1, r2, r3, r4);
+}
+
+void mul_word(fe out, const fe a, fe_limb b)
+{
+    carry_wide(out, (wide)a[0] * b, (wide)a[1] * b, (wide)a[2] * b,
+               (wide)a[3] * b, (wide)a[4] * b);
+}
+
+#endif /* !(LITH_DISPATCH) || defined(LITH_KERNEL_LEVEL) */
+
+void mul1(fe a, const fe b)
+{
+    mul(a, b, a);
+}
+
+/*
+ * Squaring needs 15 limb products instead of the 25 of mul, because each cross
+ * product appears twice.
+ */
+void sqr1(fe a)
+{
+    const uint64_t d0 = a[0] * 2, d1 = a[1] * 2, d2 = a[2] * 2, d3 = a[3] * 2;
+    const uint64_t a3_19 = a[3] * 19, a4_19 = a[4] * 19;
+    const wide r0 =
+        (wide)a[0] * a[0] + (wide)d1 * a4_19 + (wide)d2 * a3_19;
+    const wide r1 = (wide)d0 * a[1] + (wide)d2 * a4_19 + (wide)a[3] * a3_19;
+    const wide r2 = (wide)d0 * a[2] + (wide)a[1] * a[1] + (wide)d3 * a4_19;
+    const wide r3 = (wide)d0 * a[3] + (wide)d1 * a[2] + (wide)a[4] * a4_19;
+    const wide r4 = (wide)d0 * a[4] + (wide)d1 * a[3] + (wide)a[2] * a[2];
+    carry_wide(a, r0, r1, r2, r3, r4);
+}
+
+fe_limb canon(fe a)
+{
+    /*
+     * Canonicalize a field element a, reducing it to the least residue which
+     * is congruent to it mod 2^255-19. Returns 0 if the residue is nonzero.
+     */
+    uint64_t q, res;
+
+    /* After two carries, a < 2^255 + 19, with every limb below 2^52. */
+    carry(a);
+    carry(a);
+
+    /* q = 1 if a >= p, which is when a + 19 carries out of bit 255. */
+    q = (a[0] + 19) >> 51;
+    q = (a[1] + q) >> 51;
+    q = (a[2] + q) >> 51;
+    q = (a[3] + q) >> 51;
+    q = (a[4] + q) >> 51;
+
+    /* Subtract qp by adding 19q and dropping bit 255. */
+    a[0] += q * 19;
+    a[1] += a[0] >> 51;
+    a[0] &= MASK51;
+    a[2] += a[1] >> 51;
+    a[1] &= MASK51;
+    a[3] += a[2] >> 51;
+    a[2] &= MASK51;
+    a[4] += a[3] >> 51;
+    a[3] &= MASK51;
+    a[4] &= MASK51;
+
+    res = a[0] | a[1] | a[2] | a[3] | a[4];
+    return (fe_limb)(((wide)res - 1) >> 64);
+}
+
+#endif /* LITH_X25519_RADIX == 51 */
@@ -5,6 +5,7 @@
 
 #include <lithium/gimli.h>
 
+#include "gimli_common.h"
 #include "opt.h"
 
 static uint32_t coeff(int round)
@@ -16,6 +17,10 @@ static uint32_t coeff(int round)
 
 #if (LITH_VECTORIZE)
 
+#if (LITH_AVX512VL)
+#include <immintrin.h>
+#endif
+
 typedef uint32_t uint32x4_t __attribute__((vector_size(16), aligned(4)));
 typedef uint8_t uint8x16_t __attribute__((vector_size(16), aligned(4)));
 
@@ -25,6 +30,12 @@ typedef uint8_t uint8x16_t __attribute__((vector_size(16), aligned(4)));
 #define shuffle(x, ...) (__builtin_shuffle(x, (__typeof__(x)){__VA_ARGS__}))
 #endif
 
+/*
+ * The permutation is inlined into each of the bulk sponge kernels so the state
+ * stays in registers between blocks.
+ */
+#define ALWAYS_INLINE __inline__ __attribute__((always_inline))
+
 static uint32x4_t rol24(uint32x4_t x)
 {
 #if (LITH_SHUFFLE_ROL24)
@@ -42,12 +53,84 @@ static uint32x4_t rol24(uint32x4_t x)
 #endif
 }
 
-void gimli(uint32_t state[GIMLI_WORDS])
+#if (LITH_AVX512VL)
+
+/*
+ * Each round is computed with native rotates (vprold) and with vpternlogd
+ * merging every pair of xors, and the swaps are single lane permutes (vpshufd).
+ * The loop is unrolled by four rounds so the swap pattern needs no branches.
+ */
+#define XOR3 0x96
+
+static void sp_box(__m128i *x, __m128i *y, __m128i *z, __m128i c)
+{
+    const __m128i a = _mm_rol_epi32(*x, 24);
+    const __m128i b = _mm_rol_epi32(*y, 9);
+    const __m128i d = *z;
+    *z = _mm_ternarylogic_epi32(a, _mm_slli_epi32(d, 1),
+                                _mm_slli_epi32(_mm_and_si128(b, d), 2), XOR3);
+    *y = _mm_ternarylogic_epi32(b, a, _mm_slli_epi32(_mm_or_si128(a, d), 1),
+                                XOR3);
+    /*
+     * c is xored in before a swap instead of after it, which keeps it off the
+     * critical path through x.
+     */
+    *x = _mm_ternarylogic_epi32(d, _mm_xor_si128(b, c),
+                                _mm_slli_epi32(_mm_and_si128(a, b), 3), XOR3);
+}
+
+typedef __m128i row;
+
+static row load_row(const uint32_t *p)
+{
+    return _mm_loadu_si128((const void *)p);
+}
+
+static void store_row(uint32_t *p, row x)
+{
+    _mm_storeu_si128((void *)p, x);
+}
+
+static ALWAYS_INLINE void permute(row *px, row *py, row *pz)
+{
+    const __m128i zero = _mm_setzero_si128();
+    __m128i x = *px, y = *py, z = *pz;
+    int round;
+    for (round = 24; round > 0; round -= 4)
+    {
+        /* add constant: pattern c...c...c... etc., before the small swap */
+        const __m128i c = _mm_set_epi32(0, 0, (int)coeff(round), 0);
+        sp_box(&x, &y, &z, c);
+        /* small swap: pattern s...s...s... etc. */
+        x = _mm_shuffle_epi32(x, _MM_SHUFFLE(2, 3, 0, 1));
+        sp_box(&x, &y, &z, zero);
+        sp_box(&x, &y, &z, zero);
+        /* big swap: pattern ..S...S...S. etc. */
+        x = _mm_shuffle_epi32(x, _MM_SHUFFLE(1, 0, 3, 2));
+        sp_box(&x, &y, &z, zero);
+    }
+    *px = x;
+    *py = y;
+    *pz = z;
+}
+
+#else /* !LITH_AVX512VL */
+
+typedef uint32x4_t row;
+
+static row load_row(const uint32_t *p)
 {
-    uint32x4_t *s = (uint32x4_t *)state;
-    uint32x4_t x = s[0];
-    uint32x4_t y = s[1];
-    uint32x4_t z = s[2];
+    return *(const uint32x4_t *)p;
+}
+
+static void store_row(uint32_t *p, row x)
+{
+    *(uint32x4_t *)p = x;
+}
+
+static ALWAYS_INLINE void permute(row *px, row *py, row *pz)
+{
+    uint32x4_t x = *px, y = *py, z = *pz;
     int round;
     for (round = 24; round > 0; --round)
     {
@@ -73,14 +156,294 @@ void gimli(uint32_t state[GIMLI_WORDS])
             break;
         }
     }
-    s[0] = x;
-    s[1] = y;
-    s[2] = z;
+    *px = x;
+    *py = y;
+    *pz = z;
 }
 
-#else /* !LITH_VECTORIZE */
+#endif /* LITH_AVX512VL */
 
 void gimli(uint32_t state[GIMLI_WORDS])
+{
+    row x = load_row(&state[0]);
+    row y = load_row(&state[4]);
+    row z = load_row(&state[8]);
+    permute(&x, &y, &z);
+    store_row(&state[0], x);
+    store_row(&state[4], y);
+    store_row(&state[8], z);
+}
+
+#if (LITH_SPONGE_WORDS)
+
+/*
+ * The bulk sponge kernels keep the three rows of the state in registers for
+ * the whole run of blocks, and only store them back once at the end.
+ */
+
+static row load_block(const unsigned char *p)
+{
+#if (LITH_AVX512VL)
+    return _mm_loadu_si128((const void *)p);
+#elif (LITH_SPONGE_VECTORS)
+    return *(const block *)p;
+#else
+    return (row){gimli_load(&p[0]), gimli_load(&p[4]), gimli_load(&p[8]),
+                 gimli_load(&p[12])};
+#endif
+}
+
+static void store_block(unsigned char *p, row x)
+{
+#if (LITH_AVX512VL)
+    _mm_storeu_si128((void *)p, x);
+#elif (LITH_SPONGE_VECTORS)
+    *(block *)p = x;
+#else
+    gimli_store(&p[0], x[0]);
+    gimli_store(&p[4], x[1]);
+    gimli_store(&p[8], x[2]);
+    gimli_store(&p[12], x[3]);
+#endif
+}
+
+void gimli_absorb_blocks(uint32_t state[GIMLI_WORDS], const unsigned char *m,
+                         size_t nblocks)
+{
+    row x = load_row(&state[0]);
+    row y = load_row(&state[4]);
+    row z = load_row(&state[8]);
+    for (; nblocks > 0; --nblocks)
+    {
+        x ^= load_block(m);
+        m += GIMLI_RATE;
+        permute(&x, &y, &z);
+    }
+    store_row(&state[0], x);
+    store_row(&state[4], y);
+    store_row(&state[8], z);
+}
+
+void gimli_encrypt_blocks(uint32_t state[GIMLI_WORDS], unsigned char *c,
+                          const unsigned char *m, size_t nblocks)
+{
+    row x = load_row(&state[0]);
+    row y = load_row(&state[4]);
+    row z = load_row(&state[8]);
+    for (; nblocks > 0; --nblocks)
+    {
+        x ^= load_block(m);
+        store_block(c, x);
+        c += GIMLI_RATE;
+        m += GIMLI_RATE;
+        permute(&x, &y, &z);
+    }
+    store_row(&state[0], x);
+    store_row(&state[4], y);
+    store_row(&state[8], z);
+}
+
+void gimli_decrypt_blocks(uint32_t state[GIMLI_WORDS], unsigned char *m,
+                          const unsigned char *c, size_t nblocks)
+{
+    row x = load_row(&state[0]);
+    row y = load_row(&state[4]);
+    row z = load_row(&state[8]);
+    for (; nblocks > 0; --nblocks)
+    {
+        /*
+         * Absorbing the message back into the state after outputting it
+         * amounts to replacing the rate with the ciphertext.
+         */
+        const row cb = load_block(c);
+        store_block(m, x ^ cb);
+        x = cb;
+        m += GIMLI_RATE;
+        c += GIMLI_RATE;
+        permute(&x, &y, &z);
+    }
+    store_row(&state[0], x);
+    store_row(&state[4], y);
+    store_row(&state[8], z);
+}
+
+void gimli_overwrite_blocks(uint32_t state[GIMLI_WORDS],
+                            const unsigned char *c, size_t nblocks)
+{
+    row x = load_row(&state[0]);
+    row y = load_row(&state[4]);
+    row z = load_row(&state[8]);
+    for (; nblocks > 0; --nblocks)
+    {
+        x = load_block(c);
+        c += GIMLI_RATE;
+        permute(&x, &y, &z);
+    }
+    store_row(&state[0], x);
+    store_row(&state[4], y);
+    store_row(&state[8], z);
+}
+
+void gimli_squeeze_blocks(uint32_t state[GIMLI_WORDS], unsigned char *h,
+                          size_t nblocks)
+{
+    row x = load_row(&state[0]);
+    row y = load_row(&state[4]);
+    row z = load_row(&state[8]);
+    for (; nblocks > 0; --nblocks)
+    {
+        permute(&x, &y, &z);
+        store_block(h, x);
+        h += GIMLI_RATE;
+    }
+    store_row(&state[0], x);
+    store_row(&state[4], y);
+    store_row(&state[8], z);
+}
+
+#endif /* LITH_SPONGE_WORDS */
+
+/*
+ * The multi-state permutations keep word i of every state in the lane vector
+ * s[i], so each lane runs the same column-wise rounds as the scalar
+ * implementation, and the swaps just exchange whole vectors. Each vector width
+ * instantiates the same body, with rol24_lanes rotating a vector in place.
+ */
+#define PERMUTE_LANES(name, vec, rol24_lanes)                                  \
+    static void name(vec s[GIMLI_WORDS])                                       \
+    {                                                                          \
+        int round;                                                             \
+        for (round = 24; round > 0; --round)                                   \
+        {                                                                      \
+            vec tmp;                                                           \
+            int column;                                                        \
+            for (column = 0; column < 4; ++column)                             \
+            {                                                                  \
+                vec x = s[column];                                             \
+                const vec y = rol(s[column + 4], 9);                           \
+                const vec z = s[column + 8];                                   \
+                rol24_lanes(&x);                                               \
+                s[column + 8] = x ^ (z << 1) ^ ((y & z) << 2);                 \
+                s[column + 4] = y ^ x ^ ((x | z) << 1);                        \
+                s[column] = z ^ y ^ ((x & y) << 3);                            \
+            }                                                                  \
+            switch (round & 3)                                                 \
+            {                                                                  \
+            case 0:                                                            \
+                /* small swap: pattern s...s...s... etc. */                    \
+                /* add constant: pattern c...c...c... etc. */                  \
+                tmp = s[0];                                                    \
+                s[0] = s[1] ^ coeff(round);                                    \
+                s[1] = tmp;                                                    \
+                tmp = s[2];                                                    \
+                s[2] = s[3];                                                   \
+                s[3] = tmp;                                                    \
+                break;                                                         \
+            case 2:                                                            \
+                /* big swap: pattern ..S...S...S. etc. */                      \
+                tmp = s[0];                                                    \
+                s[0] = s[2];                                                   \
+                s[2] = tmp;                                                    \
+                tmp = s[1];                                                    \
+                s[1] = s[3];                                                   \
+                s[3] = tmp;                                                    \
+                break;                                                         \
+            }                                                                  \
+        }                                                                      \
+    }
+
+static void rol24_x4(uint32x4_t *x)
+{
+    *x = rol24(*x);
+}
+
+PERMUTE_LANES(permute_x4, uint32x4_t, rol24_x4)
+
+void gimli_x4(uint32_t states[4][GIMLI_WORDS])
+{
+    uint32x4_t s[GIMLI_WORDS];
+    unsigned i, lane;
+    for (i = 0; i < GIMLI_WORDS; ++i)
+    {
+        for (lane = 0; lane < 4; ++lane)
+        {
+            s[i][lane] = states[lane][i];
+        }
+    }
+    permute_x4(s);
+    for (i = 0; i < GIMLI_WORDS; ++i)
+    {
+        for (lane = 0; lane < 4; ++lane)
+        {
+            states[lane][i] = s[i][lane];
+        }
+    }
+}
+
+#if (LITH_VECTORIZE_X8)
+
+/*
+ * 256-bit vectors are only accessed through pointers, because passing them by
+ * value changes the ABI on targets without 256-bit registers.
+ */
+typedef uint32_t uint32x8_t __attribute__((vector_size(32), aligned(4)));
+typedef uint8_t uint8x32_t __attribute__((vector_size(32), aligned(4)));
+
+static void rol24_x8(uint32x8_t *x)
+{
+#if (LITH_SHUFFLE_ROL24)
+    uint8x32_t xb = (uint8x32_t)*x;
+#if (LITH_LITTLE_ENDIAN)
+    xb = shuffle(xb, 1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12, 17,
+                 18, 19, 16, 21, 22, 23, 20, 25, 26, 27, 24, 29, 30, 31, 28);
+#elif (LITH_BIG_ENDIAN)
+    xb = shuffle(xb, 3, 0, 1, 2, 7, 4, 5, 6, 11, 8, 9, 10, 15, 12, 13, 14, 19,
+                 16, 17, 18, 23, 20, 21, 22, 27, 24, 25, 26, 31, 28, 29, 30);
+#else
+#error "no byte order to use for byte shuffle implementation of rol24"
+#endif
+    *x = (uint32x8_t)xb;
+#else
+    *x = rol(*x, 24);
+#endif
+}
+
+PERMUTE_LANES(permute_x8, uint32x8_t, rol24_x8)
+
+void gimli_x8(uint32_t states[8][GIMLI_WORDS])
+{
+    uint32x8_t s[GIMLI_WORDS];
+    unsigned i, lane;
+    for (i = 0; i < GIMLI_WORDS; ++i)
+    {
+        for (lane = 0; lane < 8; ++lane)
+        {
+            s[i][lane] = states[lane][i];
+        }
+    }
+    permute_x8(s);
+    for (i = 0; i < GIMLI_WORDS; ++i)
+    {
+        for (lane = 0; lane < 8; ++lane)
+        {
+            states[lane][i] = s[i][lane];
+        }
+    }
+}
+
+#else /* !LITH_VECTORIZE_X8 */
+
+void gimli_x8(uint32_t states[8][GIMLI_WORDS])
+{
+    gimli_x4(&states[0]);
+    gimli_x4(&states[4]);
+}
+
+#endif /* LITH_VECTORIZE_X8 */
+
+#else /* !LITH_VECTORIZE */
+
+static void permute(uint32_t state[GIMLI_WORDS])
 {
     int round;
     for (round = 24; round > 0; --round)
@@ -121,4 +484,173 @@ void gimli(uint32_t state[GIMLI_WORDS])
     }
 }
 
+void gimli(uint32_t state[GIMLI_WORDS])
+{
+    permute(state);
+}
+
+void gimli_x4(uint32_t states[4][GIMLI_WORDS])
+{
+    unsigned lane;
+    for (lane = 0; lane < 4; ++lane)
+    {
+        gimli(states[lane]);
+    }
+}
+
+void gimli_x8(uint32_t states[8][GIMLI_WORDS])
+{
+    unsigned lane;
+    for (lane = 0; lane < 8; ++lane)
+    {
+        gimli(states[lane]);
+    }
+}
+
+#if (LITH_SPONGE_WORDS)
+
+/*
+ * The bulk sponge kernels work on a local copy of the state, which the
+ * compiler can keep in registers because it can't alias the input or output.
+ */
+
+void gimli_absorb_blocks(uint32_t state[GIMLI_WORDS], const unsigned char *m,
+                         size_t nblocks)
+{
+    uint32_t s[GIMLI_WORDS];
+    size_t i;
+    for (i = 0; i < GIMLI_WORDS; ++i)
+    {
+        s[i] = state[i];
+    }
+    for (; nblocks > 0; --nblocks)
+    {
+        for (i = 0; i < GIMLI_RATE / 4; ++i)
+        {
+            s[i] ^= gimli_load(m);
+            m += 4;
+        }
+        permute(s);
+    }
+    for (i = 0; i < GIMLI_WORDS; ++i)
+    {
+        state[i] = s[i];
+    }
+}
+
+void gimli_encrypt_blocks(uint32_t state[GIMLI_WORDS], unsigned char *c,
+                          const unsigned char *m, size_t nblocks)
+{
+    uint32_t s[GIMLI_WORDS];
+    size_t i;
+    for (i = 0; i < GIMLI_WORDS; ++i)
+    {
+        s[i] = state[i];
+    }
+    for (; nblocks > 0; --nblocks)
+    {
+        for (i = 0; i < GIMLI_RATE / 4; ++i)
+        {
+            s[i] ^= gimli_load(m);
+            gimli_store(c, s[i]);
+            c += 4;
+            m += 4;
+        }
+        permute(s);
+    }
+    for (i = 0; i < GIMLI_WORDS; ++i)
+    {
+        state[i] = s[i];
+    }
+}
+
+void gimli_decrypt_blocks(uint32_t state[GIMLI_WORDS], unsigned char *m,
+                          const unsigned char *c, size_t nblocks)
+{
+    uint32_t s[GIMLI_WORDS];
+    size_t i;
+    for (i = 0; i < GIMLI_WORDS; ++i)
+    {
+        s[i] = state[i];
+    }
+    for (; nblocks > 0; --nblocks)
+    {
+        /*
+         * We absorb the message data back into the gimli_state after
+         * outputting it, which amounts to:
+         * state ^= m;
+         * but we can rewrite as:
+         * state ^= state ^ c;
+         * and again as:
+         * state = state ^ state ^ c;
+         * and finally:
+         * state = c;
+         * This is easy to do when operating on words or blocks.
+         */
+        for (i = 0; i < GIMLI_RATE / 4; ++i)
+        {
+            const uint32_t cw = gimli_load(c);
+            gimli_store(m, s[i] ^ cw);
+            s[i] = cw;
+            m += 4;
+            c += 4;
+        }
+        permute(s);
+    }
+    for (i = 0; i < GIMLI_WORDS; ++i)
+    {
+        state[i] = s[i];
+    }
+}
+
+void gimli_overwrite_blocks(uint32_t state[GIMLI_WORDS],
+                            const unsigned char *c, size_t nblocks)
+{
+    uint32_t s[GIMLI_WORDS];
+    size_t i;
+    for (i = 0; i < GIMLI_WORDS; ++i)
+    {
+        s[i] = state[i];
+    }
+    for (; nblocks > 0; --nblocks)
+    {
+        for (i = 0; i < GIMLI_RATE / 4; ++i)
+        {
+            s[i] = gimli_load(c);
+            c += 4;
+        }
+        permute(s);
+    }
+    for (i = 0; i < GIMLI_WORDS; ++i)
+    {
+        state[i] = s[i];
+    }
+}
+
+void gimli_squeeze_blocks(uint32_t state[GIMLI_WORDS], unsigned char *h,
+                          size_t nblocks)
+{
+    uint32_t s[GIMLI_WORDS];
+    size_t i;
+    for (i = 0; i < GIMLI_WORDS; ++i)
+    {
+        s[i] = state[i];
+    }
+    for (; nblocks > 0; --nblocks)
+    {
+        permute(s);
+        for (i = 0; i < GIMLI_RATE / 4; ++i)
+        {
+            gimli_store(h, s[i]);
+            h += 4;
+        }
+    }
+    for (i = 0; i < GIMLI_WORDS; ++i)
+    {
+        state[i] = s[i];
+    }
+}
+
+#endif /* LITH_SPONGE_WORDS */
+
 #endif /* LITH_VECTORIZE */
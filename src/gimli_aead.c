@@ -3,6 +3,7 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <lithium/gimli.h>
 #include <lithium/gimli_aead.h>
 
 #include "gimli_common.h"
@@ -64,30 +65,21 @@ void gimli_aead_encrypt_update(gimli_state *g, unsigned char *c,
         c += first_block_len;
         m += first_block_len;
         len -= first_block_len;
-        do
-        {
-#if (LITH_SPONGE_VECTORS)
-            *(block *)c = (*(block *)g->state ^= *(const block *)m);
-            c += GIMLI_RATE;
-            m += GIMLI_RATE;
-#else
-            size_t i;
-            for (i = 0; i < GIMLI_RATE / 4; ++i)
-            {
-                g->state[i] ^= gimli_load(m);
-                gimli_store(c, g->state[i]);
-                c += 4;
-                m += 4;
-            }
-#endif
-            gimli(g->state);
-            len -= GIMLI_RATE;
-        } while (len >= GIMLI_RATE);
+        gimli_encrypt_blocks(g->state, c, m, len / GIMLI_RATE);
+        c += len - (len % GIMLI_RATE);
+        m += len - (len % GIMLI_RATE);
+        len %= GIMLI_RATE;
     }
 #endif
     encrypt_update(g, c, m, len);
 }
 
+void gimli_aead_encrypt_updatev(gimli_state *g, unsigned char *const out[],
+                                const struct lith_iovec *in, size_t n)
+{
+    gimli_updatev(g, out, in, n, gimli_aead_encrypt_update);
+}
+
 void gimli_aead_encrypt_final(gimli_state *g, unsigned char *t, size_t len)
 {
     gimli_pad(g);
@@ -117,45 +109,21 @@ void gimli_aead_decrypt_update(gimli_state *g, unsigned char *m,
         m += first_block_len;
         c += first_block_len;
         len -= first_block_len;
-        do
-        {
-            /*
-             * We absorb the message data back into the gimli_state after
-             * outputting it, which amounts to:
-             * g->state ^= m;
-             * but we can rewrite as:
-             * g->state ^= g->state ^ c;
-             * and again as:
-             * g->state = g->state ^ g->state ^ c;
-             * and finally:
-             * g->state = c;
-             * This is easy to do when operating on words or blocks.
-             */
-#if (LITH_SPONGE_VECTORS)
-            const block cb = *(const block *)c;
-            *(block *)m = *(block *)g->state ^ cb;
-            *(block *)g->state = cb;
-            m += GIMLI_RATE;
-            c += GIMLI_RATE;
-#else
-            size_t i;
-            for (i = 0; i < GIMLI_RATE / 4; ++i)
-            {
-                const uint32_t cw = gimli_load(c);
-                gimli_store(m, g->state[i] ^ cw);
-                g->state[i] = cw;
-                m += 4;
-                c += 4;
-            }
-#endif
-            gimli(g->state);
-            len -= GIMLI_RATE;
-        } while (len >= GIMLI_RATE);
+        gimli_decrypt_blocks(g->state, m, c, len / GIMLI_RATE);
+        m += len - (len % GIMLI_RATE);
+        c += len - (len % GIMLI_RATE);
+        len %= GIMLI_RATE;
     }
 #endif
     decrypt_update(g, m, c, len);
 }
 
+void gimli_aead_decrypt_updatev(gimli_state *g, unsigned char *const out[],
+                                const struct lith_iovec *in, size_t n)
+{
+    gimli_updatev(g, out, in, n, gimli_aead_decrypt_update);
+}
+
 bool gimli_aead_decrypt_final(gimli_state *g, const unsigned char *t,
                               size_t tlen)
 {
@@ -171,6 +139,34 @@ bool gimli_aead_decrypt_final(gimli_state *g, const unsigned char *t,
     return mismatch == 0;
 }
 
+static void verify_update(gimli_state *g, const unsigned char *c, size_t len)
+{
+    size_t i;
+    for (i = 0; i < len; ++i)
+    {
+        gimli_absorb_byte(g, c[i] ^ gimli_squeeze_byte(g));
+        gimli_advance(g);
+    }
+}
+
+void gimli_aead_verify_update(gimli_state *g, const unsigned char *c,
+                              size_t len)
+{
+#if (LITH_SPONGE_WORDS)
+    const size_t first_block_len = (GIMLI_RATE - g->offset) % GIMLI_RATE;
+    if (len >= GIMLI_RATE + first_block_len)
+    {
+        verify_update(g, c, first_block_len);
+        c += first_block_len;
+        len -= first_block_len;
+        gimli_overwrite_blocks(g->state, c, len / GIMLI_RATE);
+        c += len - (len % GIMLI_RATE);
+        len %= GIMLI_RATE;
+    }
+#endif
+    verify_update(g, c, len);
+}
+
 void gimli_aead_encrypt(unsigned char *c, unsigned char *t, size_t tlen,
                         const unsigned char *m, size_t len,
                         const unsigned char *ad, size_t adlen,
@@ -207,3 +203,305 @@ bool gimli_aead_decrypt(unsigned char *m, const unsigned char *c, size_t len,
     }
     return success;
 }
+
+bool gimli_aead_verify(const unsigned char *c, size_t len,
+                       const unsigned char *t, size_t tlen,
+                       const unsigned char *ad, size_t adlen,
+                       const unsigned char n[GIMLI_AEAD_NONCE_LEN],
+                       const unsigned char k[GIMLI_AEAD_KEY_LEN])
+{
+    gimli_state g;
+    gimli_aead_init(&g, n, k);
+    gimli_aead_update_ad(&g, ad, adlen);
+    gimli_aead_final_ad(&g);
+    gimli_aead_verify_update(&g, c, len);
+    return gimli_aead_decrypt_final(&g, t, tlen);
+}
+
+bool gimli_aead_decrypt_verified(unsigned char *m, const unsigned char *c,
+                                 size_t len, const unsigned char *t,
+                                 size_t tlen, const unsigned char *ad,
+                                 size_t adlen,
+                                 const unsigned char n[GIMLI_AEAD_NONCE_LEN],
+                                 const unsigned char k[GIMLI_AEAD_KEY_LEN])
+{
+    gimli_state g;
+    if (!gimli_aead_verify(c, len, t, tlen, ad, adlen, n, k))
+    {
+        return false;
+    }
+    gimli_aead_init(&g, n, k);
+    gimli_aead_update_ad(&g, ad, adlen);
+    gimli_aead_final_ad(&g);
+    gimli_aead_decrypt_update(&g, m, c, len);
+    return true;
+}
+
+#define LANES 8
+
+enum phase
+{
+    PHASE_INIT,
+    PHASE_AD,
+    PHASE_DATA,
+    PHASE_TAG
+};
+
+struct lane
+{
+    size_t pkt;
+    size_t pos;
+    size_t tpos;
+    enum phase phase;
+    unsigned char mismatch;
+};
+
+struct packets
+{
+    unsigned char *const *out;
+    const unsigned char *const *in;
+    const size_t *len;
+    unsigned char *const *tout;
+    const unsigned char *const *tin;
+    size_t tlen;
+    const unsigned char *const *ad;
+    const size_t *adlen;
+    const unsigned char *const *n;
+    const unsigned char *const *k;
+    bool *ok;
+    size_t count;
+};
+
+static void crypt_block(uint32_t s[GIMLI_WORDS], unsigned char *out,
+                        const unsigned char *in, bool decrypt)
+{
+    unsigned j;
+    for (j = 0; j < GIMLI_RATE / 4; ++j)
+    {
+        const uint32_t w = gimli_load(&in[j * 4]);
+        const uint32_t x = s[j] ^ w;
+        gimli_store(&out[j * 4], x);
+        s[j] = decrypt ? w : x;
+    }
+}
+
+static void crypt_tail(uint32_t s[GIMLI_WORDS], unsigned char *out,
+                       const unsigned char *in, size_t len, bool decrypt)
+{
+    size_t i;
+    for (i = 0; i < len; ++i)
+    {
+        const unsigned shift = (unsigned)(i % 4) * 8;
+        const unsigned char x = (unsigned char)(in[i] ^ (s[i / 4] >> shift));
+        s[i / 4] ^= (uint32_t)(decrypt ? x : in[i]) << shift;
+        out[i] = x;
+    }
+    gimli_pad_words(s, len);
+}
+
+/*
+ * Run the init, associated data, or data step of a lane that comes before its
+ * next permutation.
+ */
+static void lane_step(uint32_t s[GIMLI_WORDS], struct lane *l,
+                      const struct packets *p)
+{
+    const size_t i = l->pkt;
+    size_t rem;
+    switch (l->phase)
+    {
+    case PHASE_INIT:
+        load_words(s, p->n[i], 4);
+        load_words(&s[4], p->k[i], 8);
+        l->phase = PHASE_AD;
+        break;
+    case PHASE_AD:
+        rem = p->adlen[i] - l->pos;
+        if (rem >= GIMLI_RATE)
+        {
+            unsigned j;
+            for (j = 0; j < GIMLI_RATE / 4; ++j)
+            {
+                s[j] ^= gimli_load(&p->ad[i][l->pos + j * 4]);
+            }
+            l->pos += GIMLI_RATE;
+        }
+        else
+        {
+            gimli_absorb_tail(s, &p->ad[i][l->pos], rem);
+            l->pos = 0;
+            l->phase = PHASE_DATA;
+        }
+        break;
+    case PHASE_DATA:
+        rem = p->len[i] - l->pos;
+        if (rem >= GIMLI_RATE)
+        {
+            crypt_block(s, &p->out[i][l->pos], &p->in[i][l->pos],
+                        p->tin != NULL);
+            l->pos += GIMLI_RATE;
+        }
+        else
+        {
+            crypt_tail(s, &p->out[i][l->pos], &p->in[i][l->pos], rem,
+                       p->tin != NULL);
+            l->phase = PHASE_TAG;
+        }
+        break;
+    case PHASE_TAG:
+        break;
+    }
+}
+
+/*
+ * Write or check the next block of a lane's tag. Returns true when the tag is
+ * complete.
+ */
+static bool lane_tag(const uint32_t s[GIMLI_WORDS], struct lane *l,
+                     const struct packets *p)
+{
+    unsigned char tag[GIMLI_RATE];
+    size_t len = p->tlen - l->tpos, i;
+    if (len > GIMLI_RATE)
+    {
+        len = GIMLI_RATE;
+    }
+    for (i = 0; i < GIMLI_RATE / 4; ++i)
+    {
+        gimli_store(&tag[i * 4], s[i]);
+    }
+    if (p->tout != NULL)
+    {
+        (void)memcpy(&p->tout[l->pkt][l->tpos], tag, len);
+    }
+    else
+    {
+        for (i = 0; i < len; ++i)
+        {
+            l->mismatch |= p->tin[l->pkt][l->tpos + i] ^ tag[i];
+        }
+    }
+    l->tpos += len;
+    return l->tpos == p->tlen;
+}
+
+static void lane_next(struct lane *l, size_t *next, const struct packets *p)
+{
+    l->pkt = *next < p->count ? (*next)++ : p->count;
+    l->pos = 0;
+    l->tpos = 0;
+    l->phase = PHASE_INIT;
+    l->mismatch = 0;
+}
+
+static bool aead_many(const struct packets *p)
+{
+    uint32_t s[LANES][GIMLI_WORDS];
+    struct lane lanes[LANES];
+    size_t next = 0, active = 0;
+    bool all_ok = true;
+    unsigned i;
+
+    for (i = 0; i < LANES; ++i)
+    {
+        lane_next(&lanes[i], &next, p);
+        if (lanes[i].pkt < p->count)
+        {
+            ++active;
+        }
+    }
+
+    (void)memset(s, 0, sizeof s);
+    while (active > 0)
+    {
+        for (i = 0; i < LANES; ++i)
+        {
+            if (lanes[i].pkt < p->count)
+            {
+                lane_step(s[i], &lanes[i], p);
+            }
+        }
+
+        gimli_x8(s);
+
+        for (i = 0; i < LANES; ++i)
+        {
+            struct lane *const l = &lanes[i];
+            if (l->pkt == p->count || l->phase != PHASE_TAG ||
+                !lane_tag(s[i], l, p))
+            {
+                continue;
+            }
+            if (p->tin != NULL)
+            {
+                const bool success = l->mismatch == 0;
+                const unsigned char mask =
+                    (unsigned char)(~(unsigned int)success + 1);
+                size_t j;
+                for (j = 0; j < p->len[l->pkt]; ++j)
+                {
+                    p->out[l->pkt][j] &= mask;
+                }
+                if (p->ok != NULL)
+                {
+                    p->ok[l->pkt] = success;
+                }
+                all_ok &= success;
+            }
+            lane_next(l, &next, p);
+            if (l->pkt == p->count)
+            {
+                --active;
+            }
+        }
+    }
+    return all_ok;
+}
+
+void gimli_aead_encrypt_many(unsigned char *const c[], unsigned char *const t[],
+                             size_t tlen, const unsigned char *const m[],
+                             const size_t len[],
+                             const unsigned char *const ad[],
+                             const size_t adlen[],
+                             const unsigned char *const n[],
+                             const unsigned char *const k[], size_t count)
+{
+    struct packets p;
+    p.out = c;
+    p.in = m;
+    p.len = len;
+    p.tout = t;
+    p.tin = NULL;
+    p.tlen = tlen;
+    p.ad = ad;
+    p.adlen = adlen;
+    p.n = n;
+    p.k = k;
+    p.ok = NULL;
+    p.count = count;
+    (void)aead_many(&p);
+}
+
+bool gimli_aead_decrypt_many(unsigned char *const m[], bool ok[],
+                             const unsigned char *const c[], const size_t len[],
+                             const unsigned char *const t[], size_t tlen,
+                             const unsigned char *const ad[],
+                             const size_t adlen[],
+                             const unsigned char *const n[],
+                             const unsigned char *const k[], size_t count)
+{
+    struct packets p;
+    p.out = m;
+    p.in = c;
+    p.len = len;
+    p.tout = NULL;
+    p.tin = t;
+    p.tlen = tlen;
+    p.ad = ad;
+    p.adlen = adlen;
+    p.n = n;
+    p.k = k;
+    p.ok = ok;
+    p.count = count;
+    return aead_many(&p);
+}
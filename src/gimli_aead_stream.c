@@ -0,0 +1,227 @@
+/*
+ * Part of liblithium, under the Apache License v2.0.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <lithium/gimli_aead_stream.h>
+
+#include <lithium/dispatch.h>
+
+#include "dispatch.h"
+#include "opt.h"
+
+#include <string.h>
+
+#define TAG_LEN GIMLI_AEAD_TAG_DEFAULT_LEN
+
+/* The number of chunks set up at a time. */
+#define BATCH 16
+
+struct batch
+{
+    unsigned char nonces[BATCH][GIMLI_AEAD_NONCE_LEN];
+    unsigned char *out[BATCH];
+    unsigned char *tag[BATCH];
+    const unsigned char *in[BATCH];
+    const unsigned char *ctag[BATCH];
+    size_t len[BATCH];
+    const unsigned char *ad[BATCH];
+    size_t adlen[BATCH];
+    const unsigned char *n[BATCH];
+    const unsigned char *k[BATCH];
+};
+
+void gimli_aead_stream_nonce(unsigned char n[GIMLI_AEAD_NONCE_LEN],
+                             const unsigned char
+                                 prefix[GIMLI_AEAD_STREAM_PREFIX_LEN],
+                             uint32_t index, bool last)
+{
+    (void)memcpy(n, prefix, GIMLI_AEAD_STREAM_PREFIX_LEN);
+    n[GIMLI_AEAD_STREAM_PREFIX_LEN] = (unsigned char)(index >> 24);
+    n[GIMLI_AEAD_STREAM_PREFIX_LEN + 1] = (unsigned char)(index >> 16);
+    n[GIMLI_AEAD_STREAM_PREFIX_LEN + 2] = (unsigned char)(index >> 8);
+    n[GIMLI_AEAD_STREAM_PREFIX_LEN + 3] = (unsigned char)index;
+    n[GIMLI_AEAD_STREAM_PREFIX_LEN + 4] = last ? 1 : 0;
+}
+
+size_t gimli_aead_stream_len(size_t len, size_t chunk_len)
+{
+    size_t nchunks;
+    if (chunk_len == 0)
+    {
+        return 0;
+    }
+    nchunks = len / chunk_len;
+    if (len % chunk_len != 0 || len == 0)
+    {
+        ++nchunks;
+    }
+    return len + nchunks * TAG_LEN;
+}
+
+/*
+ * Count the chunks in a range of len bytes, where every chunk but the last one
+ * of the stream has stride bytes, and the last one has at least min_last.
+ */
+static bool count_chunks(size_t *nchunks, size_t len, size_t stride,
+                         size_t min_last, uint32_t first_chunk, bool last)
+{
+    size_t full, rem;
+    if (stride <= min_last)
+    {
+        return false;
+    }
+    full = len / stride;
+    rem = len % stride;
+    if (!last || (rem == 0 && full > 0))
+    {
+        if (rem != 0)
+        {
+            return false;
+        }
+        *nchunks = full;
+    }
+    else
+    {
+        if (rem < min_last)
+        {
+            return false;
+        }
+        *nchunks = full + 1;
+    }
+    return *nchunks == 0 ||
+           (uint64_t)(*nchunks - 1) <= UINT32_MAX - (uint64_t)first_chunk;
+}
+
+static void set_nonce(struct batch *b, size_t j, size_t chunk, size_t nchunks,
+                      uint32_t first_chunk, bool last,
+                      const unsigned char prefix[GIMLI_AEAD_STREAM_PREFIX_LEN],
+                      const unsigned char k[GIMLI_AEAD_KEY_LEN])
+{
+    gimli_aead_stream_nonce(b->nonces[j], prefix, first_chunk + (uint32_t)chunk,
+                            last && chunk == nchunks - 1);
+    b->n[j] = b->nonces[j];
+    b->k[j] = k;
+    b->ad[j] = NULL;
+    b->adlen[j] = 0;
+}
+
+/*
+ * Chunks are run in the lanes of gimli_x8 when it has eight-lane vectors, which
+ * a dispatch build only knows once it has bound its kernels. Otherwise, each
+ * chunk is faster on its own, through the single-state bulk sponge kernels.
+ */
+static bool use_lanes(void)
+{
+#if (LITH_DISPATCH)
+    return lith_dispatch_level() >= LITH_LEVEL_AVX2;
+#else
+    return LITH_VECTORIZE_X8;
+#endif
+}
+
+static void encrypt_batch(struct batch *b, size_t n)
+{
+    size_t i;
+    if (use_lanes())
+    {
+        gimli_aead_encrypt_many(b->out, b->tag, TAG_LEN, b->in, b->len, b->ad,
+                                b->adlen, b->n, b->k, n);
+        return;
+    }
+    for (i = 0; i < n; ++i)
+    {
+        gimli_aead_encrypt(b->out[i], b->tag[i], TAG_LEN, b->in[i], b->len[i],
+                           b->ad[i], b->adlen[i], b->n[i], b->k[i]);
+    }
+}
+
+static bool decrypt_batch(struct batch *b, size_t n)
+{
+    bool success = true;
+    size_t i;
+    if (use_lanes())
+    {
+        return gimli_aead_decrypt_many(b->out, NULL, b->in, b->len, b->ctag,
+                                       TAG_LEN, b->ad, b->adlen, b->n, b->k,
+                                       n);
+    }
+    for (i = 0; i < n; ++i)
+    {
+        if (!gimli_aead_decrypt(b->out[i], b->in[i], b->len[i], b->ctag[i],
+                                TAG_LEN, b->ad[i], b->adlen[i], b->n[i],
+                                b->k[i]))
+        {
+            success = false;
+        }
+    }
+    return success;
+}
+
+bool gimli_aead_stream_encrypt(unsigned char *c, const unsigned char *m,
+                               size_t len, size_t chunk_len,
+                               uint32_t first_chunk, bool last,
+                               const unsigned char
+                                   prefix[GIMLI_AEAD_STREAM_PREFIX_LEN],
+                               const unsigned char k[GIMLI_AEAD_KEY_LEN])
+{
+    struct batch b;
+    size_t nchunks, i, j;
+    if (!count_chunks(&nchunks, len, chunk_len, 0, first_chunk, last))
+    {
+        return false;
+    }
+    for (i = 0; i < nchunks; i += j)
+    {
+        for (j = 0; j < BATCH && i + j < nchunks; ++j)
+        {
+            const size_t chunk = i + j, off = chunk * chunk_len;
+            b.len[j] = len - off < chunk_len ? len - off : chunk_len;
+            b.in[j] = &m[off];
+            b.out[j] = &c[off + chunk * TAG_LEN];
+            b.tag[j] = &b.out[j][b.len[j]];
+            set_nonce(&b, j, chunk, nchunks, first_chunk, last, prefix, k);
+        }
+        encrypt_batch(&b, j);
+    }
+    return true;
+}
+
+bool gimli_aead_stream_decrypt(unsigned char *m, const unsigned char *c,
+                               size_t clen, size_t chunk_len,
+                               uint32_t first_chunk, bool last,
+                               const unsigned char
+                                   prefix[GIMLI_AEAD_STREAM_PREFIX_LEN],
+                               const unsigned char k[GIMLI_AEAD_KEY_LEN])
+{
+    struct batch b;
+    const size_t stride = chunk_len + TAG_LEN;
+    size_t nchunks, i, j;
+    bool success = true;
+    if (stride < chunk_len ||
+        !count_chunks(&nchunks, clen, stride, TAG_LEN, first_chunk, last))
+    {
+        return false;
+    }
+    for (i = 0; i < nchunks; i += j)
+    {
+        for (j = 0; j < BATCH && i + j < nchunks; ++j)
+        {
+            const size_t chunk = i + j, off = chunk * stride;
+            b.len[j] = (clen - off < stride ? clen - off : stride) - TAG_LEN;
+            b.in[j] = &c[off];
+            b.ctag[j] = &b.in[j][b.len[j]];
+            b.out[j] = &m[chunk * chunk_len];
+            set_nonce(&b, j, chunk, nchunks, first_chunk, last, prefix, k);
+        }
+        if (!decrypt_batch(&b, j))
+        {
+            success = false;
+        }
+    }
+    if (!success)
+    {
+        (void)memset(m, 0, clen - nchunks * TAG_LEN);
+    }
+    return success;
+}
@@ -55,9 +55,37 @@ unsigned char gimli_squeeze_byte(const gimli_state *g)
 #endif
 }
 
-void gimli_advance(gimli_state *g)
+void gimli_state_export(unsigned char out[GIMLI_STATE_EXPORT_LEN],
+                        const gimli_state *g)
 {
-    ++g->offset;
+    size_t i;
+    for (i = 0; i < GIMLI_WORDS; ++i)
+    {
+        gimli_store(&out[i * 4], g->state[i]);
+    }
+    out[GIMLI_WORDS * 4] = (unsigned char)g->offset;
+}
+
+bool gimli_state_import(gimli_state *g,
+                        const unsigned char in[GIMLI_STATE_EXPORT_LEN])
+{
+    size_t i;
+    /* The absorb and squeeze functions never leave a full rate unpermuted. */
+    if (in[GIMLI_WORDS * 4] >= GIMLI_RATE)
+    {
+        return false;
+    }
+    for (i = 0; i < GIMLI_WORDS; ++i)
+    {
+        g->state[i] = gimli_load(&in[i * 4]);
+    }
+    g->offset = in[GIMLI_WORDS * 4];
+    return true;
+}
+
+static void advance(gimli_state *g, unsigned n)
+{
+    g->offset += n;
     if (g->offset == GIMLI_RATE)
     {
 #if (LITH_ENABLE_WATCHDOG)
@@ -68,14 +96,44 @@ void gimli_advance(gimli_state *g)
     }
 }
 
+void gimli_advance(gimli_state *g)
+{
+    advance(g, 1);
+}
+
 static void absorb(gimli_state *g, const unsigned char *m, size_t len)
 {
+#if (LITH_SPONGE_WORDS)
+    /*
+     * Absorb a word at a time whenever the offset is word aligned, so short and
+     * unaligned updates only take the byte path for at most 3 bytes at each
+     * end.
+     */
+    while (len > 0)
+    {
+        if (g->offset % 4 == 0 && len >= 4)
+        {
+            g->state[g->offset / 4] ^= gimli_load(m);
+            m += 4;
+            len -= 4;
+            advance(g, 4);
+        }
+        else
+        {
+            gimli_absorb_byte(g, *m);
+            ++m;
+            --len;
+            advance(g, 1);
+        }
+    }
+#else
     size_t i;
     for (i = 0; i < len; ++i)
     {
         gimli_absorb_byte(g, m[i]);
         gimli_advance(g);
     }
+#endif
 }
 
 void gimli_absorb(gimli_state *g, const unsigned char *m, size_t len)
@@ -87,31 +145,100 @@ void gimli_absorb(gimli_state *g, const unsigned char *m, size_t len)
         absorb(g, m, first_block_len);
         m += first_block_len;
         len -= first_block_len;
-        do
+        gimli_absorb_blocks(g->state, m, len / GIMLI_RATE);
+        m += len - (len % GIMLI_RATE);
+        len %= GIMLI_RATE;
+    }
+#endif
+    absorb(g, m, len);
+}
+
+static void flush(gimli_state *g, unsigned char *const dst[],
+                  const unsigned char *staged, size_t len,
+                  gimli_update_fn update)
+{
+    unsigned char processed[GIMLI_RATE];
+    size_t i;
+    update(g, processed, staged, len);
+    if (dst != NULL)
+    {
+        for (i = 0; i < len; ++i)
         {
-#if (LITH_SPONGE_VECTORS)
-            *(block *)g->state ^= *(const block *)m;
-            m += GIMLI_RATE;
-#else
-            size_t i;
-            for (i = 0; i < GIMLI_RATE / 4; ++i)
+            *dst[i] = processed[i];
+        }
+    }
+}
+
+void gimli_updatev(gimli_state *g, unsigned char *const out[],
+                   const struct lith_iovec *in, size_t n,
+                   gimli_update_fn update)
+{
+    unsigned char staged[GIMLI_RATE];
+    unsigned char *dst[GIMLI_RATE];
+    size_t nstaged = 0, i;
+
+    for (i = 0; i < n; ++i)
+    {
+        const unsigned char *m = in[i].base;
+        unsigned char *c = (out != NULL) ? out[i] : NULL;
+        size_t len = in[i].len;
+        while (len > 0)
+        {
+            /* The offset doesn't change while bytes are staged. */
+            const size_t want = GIMLI_RATE - g->offset - nstaged;
+            size_t k, j;
+            if (nstaged == 0 && len >= want)
             {
-                g->state[i] ^= gimli_load(m);
-                m += 4;
+                /* Finish the current block and any whole blocks in place. */
+                k = len - ((len - want) % GIMLI_RATE);
+                update(g, c, m, k);
             }
-#endif
-            gimli(g->state);
-            len -= GIMLI_RATE;
-        } while (len >= GIMLI_RATE);
+            else
+            {
+                /* Gather the block from this and later fragments. */
+                k = (len < want) ? len : want;
+                for (j = 0; j < k; ++j)
+                {
+                    staged[nstaged] = m[j];
+                    if (c != NULL)
+                    {
+                        dst[nstaged] = &c[j];
+                    }
+                    ++nstaged;
+                }
+                if (k == want)
+                {
+                    flush(g, (out != NULL) ? dst : NULL, staged, nstaged,
+                          update);
+                    nstaged = 0;
+                }
+            }
+            m += k;
+            if (c != NULL)
+            {
+                c += k;
+            }
+            len -= k;
+        }
+    }
+    if (nstaged > 0)
+    {
+        flush(g, (out != NULL) ? dst : NULL, staged, nstaged, update);
     }
-#endif
-    absorb(g, m, len);
 }
 
 void gimli_squeeze(gimli_state *g, unsigned char *h, size_t len)
 {
     size_t i;
     g->offset = GIMLI_RATE - 1;
+#if (LITH_SPONGE_WORDS)
+    if (len >= GIMLI_RATE)
+    {
+        gimli_squeeze_blocks(g->state, h, len / GIMLI_RATE);
+        h += len - (len % GIMLI_RATE);
+        len %= GIMLI_RATE;
+    }
+#endif
     for (i = 0; i < len; ++i)
     {
         gimli_advance(g);
@@ -119,6 +246,24 @@ void gimli_squeeze(gimli_state *g, unsigned char *h, size_t len)
     }
 }
 
+void gimli_absorb_tail(uint32_t state[GIMLI_WORDS], const unsigned char *m,
+                       size_t len)
+{
+    size_t i;
+    for (i = 0; i < len; ++i)
+    {
+        state[i / 4] ^= (uint32_t)m[i] << ((i % 4) * 8);
+    }
+    gimli_pad_words(state, len);
+}
+
+void gimli_pad_words(uint32_t state[GIMLI_WORDS], size_t offset)
+{
+    /* Same padding as gimli_pad at offset. */
+    state[offset / 4] ^= UINT32_C(0x01) << ((offset % 4) * 8);
+    state[GIMLI_WORDS - 1] ^= UINT32_C(0x01000000);
+}
+
 void gimli_pad(gimli_state *g)
 {
     gimli_absorb_byte(g, 0x01);
@@ -7,7 +7,9 @@
  */
 
 #include <lithium/gimli_state.h>
+#include <lithium/iovec.h>
 
+#include <stddef.h>
 #include <stdint.h>
 
 void gimli_absorb_byte(gimli_state *g, unsigned char x);
@@ -26,6 +28,64 @@ void gimli_absorb(gimli_state *g, const unsigned char *m, size_t len);
 
 void gimli_squeeze(gimli_state *g, unsigned char *h, size_t len);
 
+typedef void (*gimli_update_fn)(gimli_state *g, unsigned char *out,
+                                const unsigned char *in, size_t len);
+
+/*
+ * Run a contiguous sponge update over the fragments in[0..n), writing output
+ * for in[i] to out[i] if out is not NULL. Bytes of a block split across
+ * fragments are gathered, so each whole block is passed to update at once and
+ * takes the bulk kernel path.
+ */
+void gimli_updatev(gimli_state *g, unsigned char *const out[],
+                   const struct lith_iovec *in, size_t n,
+                   gimli_update_fn update);
+
 #define GIMLI_RATE 16U
 
+/*
+ * Absorb the final len < GIMLI_RATE bytes of a message at the start of a block
+ * and pad it, working directly on state words.
+ */
+void gimli_absorb_tail(uint32_t state[GIMLI_WORDS], const unsigned char *m,
+                       size_t len);
+
+void gimli_pad_words(uint32_t state[GIMLI_WORDS], size_t offset);
+
+/*
+ * gimli_hash_many, with every message absorbed starting from a copy of start,
+ * which must be at a block boundary (offset 0).
+ */
+void gimli_hash_many_from(const gimli_state *start, unsigned char *const h[],
+                          size_t hlen, const unsigned char *const m[],
+                          const size_t mlen[], size_t n);
+
+/*
+ * Bulk sponge kernels, used when LITH_SPONGE_WORDS is enabled. Each processes
+ * nblocks whole blocks of GIMLI_RATE bytes starting at offset 0, permuting the
+ * state after every block.
+ */
+void gimli_absorb_blocks(uint32_t state[GIMLI_WORDS], const unsigned char *m,
+                         size_t nblocks);
+
+void gimli_encrypt_blocks(uint32_t state[GIMLI_WORDS], unsigned char *c,
+                          const unsigned char *m, size_t nblocks);
+
+void gimli_decrypt_blocks(uint32_t state[GIMLI_WORDS], unsigned char *m,
+                          const unsigned char *c, size_t nblocks);
+
+/*
+ * Set the rate to each block of c before permuting, which leaves the state as
+ * gimli_decrypt_blocks does without computing the plaintext.
+ */
+void gimli_overwrite_blocks(uint32_t state[GIMLI_WORDS],
+                            const unsigned char *c, size_t nblocks);
+
+/*
+ * Squeeze nblocks whole blocks, permuting the state before each block is
+ * output, as gimli_squeeze does.
+ */
+void gimli_squeeze_blocks(uint32_t state[GIMLI_WORDS], unsigned char *h,
+                          size_t nblocks);
+
 #endif /* LITHIUM_GIMLI_COMMON_H */
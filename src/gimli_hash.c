@@ -5,8 +5,12 @@
 
 #include <lithium/gimli_hash.h>
 
+#include <lithium/gimli.h>
+
 #include "gimli_common.h"
 
+#include <stdbool.h>
+#include <stdint.h>
 #include <string.h>
 
 void gimli_hash_init(gimli_hash_state *g)
@@ -19,12 +23,30 @@ void gimli_hash_update(gimli_hash_state *g, const unsigned char *m, size_t len)
     gimli_absorb(g, m, len);
 }
 
+static void absorb_update(gimli_state *g, unsigned char *out,
+                          const unsigned char *in, size_t len)
+{
+    (void)out;
+    gimli_absorb(g, in, len);
+}
+
+void gimli_hash_updatev(gimli_hash_state *g, const struct lith_iovec *iov,
+                        size_t n)
+{
+    gimli_updatev(g, NULL, iov, n, absorb_update);
+}
+
 void gimli_hash_final(gimli_hash_state *g, unsigned char *h, size_t len)
 {
     gimli_pad(g);
     gimli_squeeze(g, h, len);
 }
 
+void gimli_hash_clone(gimli_hash_state *dst, const gimli_hash_state *src)
+{
+    *dst = *src;
+}
+
 void gimli_hash(unsigned char *h, size_t hlen, const unsigned char *m,
                 size_t mlen)
 {
@@ -33,3 +55,198 @@ void gimli_hash(unsigned char *h, size_t hlen, const unsigned char *m,
     gimli_hash_update(&g, m, mlen);
     gimli_hash_final(&g, h, hlen);
 }
+
+void gimli_xof_init(gimli_xof_state *x, const gimli_hash_state *g)
+{
+    x->g = *g;
+    gimli_pad(&x->g);
+    /* The first output block comes from the next permutation. */
+    x->used = GIMLI_RATE;
+}
+
+void gimli_xof_squeeze(gimli_xof_state *x, unsigned char *out, size_t len)
+{
+    for (; len > 0 && x->used < GIMLI_RATE; --len, ++x->used)
+    {
+        x->g.offset = x->used;
+        *out++ = gimli_squeeze_byte(&x->g);
+    }
+    if (len > 0)
+    {
+        gimli_squeeze(&x->g, out, len);
+        x->used = (unsigned)((len - 1) % GIMLI_RATE) + 1;
+    }
+}
+
+void gimli_xof_export(unsigned char out[GIMLI_STATE_EXPORT_LEN],
+                      const gimli_xof_state *x)
+{
+    gimli_state_export(out, &x->g);
+    out[GIMLI_WORDS * 4] = (unsigned char)(GIMLI_RATE + x->used);
+}
+
+bool gimli_xof_import(gimli_xof_state *x,
+                      const unsigned char in[GIMLI_STATE_EXPORT_LEN])
+{
+    const unsigned offset = in[GIMLI_WORDS * 4];
+    size_t i;
+    if (offset < GIMLI_RATE || offset > 2 * GIMLI_RATE)
+    {
+        return false;
+    }
+    for (i = 0; i < GIMLI_WORDS; ++i)
+    {
+        x->g.state[i] = gimli_load(&in[i * 4]);
+    }
+    x->g.offset = 0;
+    x->used = offset - GIMLI_RATE;
+    return true;
+}
+
+#define LANES 8U
+
+void gimli_xof_ctr(const gimli_hash_state *g, unsigned char *out, size_t len,
+                   uint64_t first_block)
+{
+    uint32_t s[LANES][GIMLI_WORDS];
+    unsigned char block[LANES * GIMLI_RATE];
+    gimli_state base = *g;
+    unsigned i, j;
+
+    gimli_pad(&base);
+    while (len > 0)
+    {
+        const size_t n = len < sizeof block ? len : sizeof block;
+        for (i = 0; i < LANES; ++i)
+        {
+            const uint64_t ctr = first_block + i;
+            (void)memcpy(s[i], base.state, sizeof s[i]);
+            s[i][0] ^= (uint32_t)(ctr & UINT32_C(0xFFFFFFFF));
+            s[i][1] ^= (uint32_t)(ctr >> 32);
+        }
+        gimli_x8(s);
+        for (i = 0; i < LANES; ++i)
+        {
+            for (j = 0; j < GIMLI_RATE / 4; ++j)
+            {
+                gimli_store(&block[i * GIMLI_RATE + j * 4], s[i][j]);
+            }
+        }
+        (void)memcpy(out, block, n);
+        out += n;
+        len -= n;
+        first_block += LANES;
+    }
+}
+
+struct lane
+{
+    size_t msg;
+    size_t pos;
+    size_t out;
+    bool squeezing;
+};
+
+void gimli_hash_many_from(const gimli_state *start, unsigned char *const h[],
+                          size_t hlen, const unsigned char *const m[],
+                          const size_t mlen[], size_t n)
+{
+    uint32_t s[LANES][GIMLI_WORDS];
+    unsigned char block[GIMLI_RATE];
+    struct lane lanes[LANES];
+    size_t next = 0, active = 0;
+    unsigned i, j;
+
+    if (hlen == 0)
+    {
+        return;
+    }
+
+    for (i = 0; i < LANES; ++i)
+    {
+        lanes[i].msg = next < n ? next++ : n;
+        lanes[i].pos = 0;
+        lanes[i].out = 0;
+        lanes[i].squeezing = false;
+        if (lanes[i].msg < n)
+        {
+            ++active;
+        }
+        (void)memcpy(s[i], start->state, sizeof s[i]);
+    }
+
+    while (active > 0)
+    {
+        for (i = 0; i < LANES; ++i)
+        {
+            struct lane *const l = &lanes[i];
+            if (l->msg == n || l->squeezing)
+            {
+                continue;
+            }
+            if (mlen[l->msg] - l->pos >= GIMLI_RATE)
+            {
+                for (j = 0; j < GIMLI_RATE / 4; ++j)
+                {
+                    s[i][j] ^= gimli_load(&m[l->msg][l->pos + j * 4]);
+                }
+                l->pos += GIMLI_RATE;
+            }
+            else
+            {
+                gimli_absorb_tail(s[i], &m[l->msg][l->pos],
+                                  mlen[l->msg] - l->pos);
+                l->squeezing = true;
+            }
+        }
+
+        gimli_x8(s);
+
+        for (i = 0; i < LANES; ++i)
+        {
+            struct lane *const l = &lanes[i];
+            size_t len;
+            if (l->msg == n || !l->squeezing)
+            {
+                continue;
+            }
+            len = hlen - l->out;
+            if (len > GIMLI_RATE)
+            {
+                len = GIMLI_RATE;
+            }
+            for (j = 0; j < GIMLI_RATE / 4; ++j)
+            {
+                gimli_store(&block[j * 4], s[i][j]);
+            }
+            (void)memcpy(&h[l->msg][l->out], block, len);
+            l->out += len;
+            if (l->out == hlen)
+            {
+                /* Refill this lane with the next message. */
+                (void)memcpy(s[i], start->state, sizeof s[i]);
+                l->pos = 0;
+                l->out = 0;
+                l->squeezing = false;
+                if (next < n)
+                {
+                    l->msg = next++;
+                }
+                else
+                {
+                    l->msg = n;
+                    --active;
+                }
+            }
+        }
+    }
+}
+
+void gimli_hash_many(unsigned char *const h[], size_t hlen,
+                     const unsigned char *const m[], const size_t mlen[],
+                     size_t n)
+{
+    gimli_state start;
+    gimli_hash_init(&start);
+    gimli_hash_many_from(&start, h, hlen, m, mlen, n);
+}
@@ -0,0 +1,48 @@
+/*
+ * Part of liblithium, under the Apache License v2.0.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <lithium/gimli_mac.h>
+
+#include <lithium/gimli_hash.h>
+
+#include "gimli_common.h"
+
+void gimli_mac_key_init(gimli_mac_key *k,
+                        const unsigned char key[GIMLI_MAC_KEY_LEN])
+{
+    gimli_hash_init(k);
+    gimli_hash_update(k, key, GIMLI_MAC_KEY_LEN);
+}
+
+void gimli_mac_init(gimli_mac_state *g, const gimli_mac_key *k)
+{
+    *g = *k;
+}
+
+void gimli_mac_update(gimli_mac_state *g, const unsigned char *m, size_t len)
+{
+    gimli_hash_update(g, m, len);
+}
+
+void gimli_mac_final(gimli_mac_state *g, unsigned char *t, size_t len)
+{
+    gimli_hash_final(g, t, len);
+}
+
+void gimli_mac(unsigned char *t, size_t tlen, const unsigned char *m,
+               size_t mlen, const gimli_mac_key *k)
+{
+    gimli_mac_state g;
+    gimli_mac_init(&g, k);
+    gimli_mac_update(&g, m, mlen);
+    gimli_mac_final(&g, t, tlen);
+}
+
+void gimli_mac_many(unsigned char *const t[], size_t tlen,
+                    const unsigned char *const m[], const size_t mlen[],
+                    size_t n, const gimli_mac_key *k)
+{
+    gimli_hash_many_from(k, t, tlen, m, mlen, n);
+}
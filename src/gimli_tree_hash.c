@@ -0,0 +1,222 @@
+/*
+ * Part of liblithium, under the Apache License v2.0.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <lithium/gimli_tree_hash.h>
+
+#include <lithium/gimli.h>
+
+#include "gimli_common.h"
+
+#include <string.h>
+
+#define LEAF_DOMAIN 0x00U
+#define ROOT_DOMAIN 0x01U
+
+#define LEAF_BLOCKS (GIMLI_TREE_HASH_LEAF_LEN / GIMLI_RATE)
+
+#define MAX_LANES 8U
+
+/*
+ * Hash lanes whole leaves at once, one per state, with the given multi-lane
+ * permutation. This computes the same sponge as absorbing leaf_i || 0x00 with
+ * gimli_hash_update and squeezing with gimli_hash_final, with the domain byte
+ * and padding folded into the state words directly.
+ */
+static void hash_leaves(unsigned char *cvs, const unsigned char *m,
+                        unsigned lanes,
+                        void (*permute)(uint32_t states[][GIMLI_WORDS]))
+{
+    uint32_t s[MAX_LANES][GIMLI_WORDS];
+    size_t b;
+    unsigned i, j;
+
+    (void)memset(s, 0, sizeof s);
+    for (b = 0; b < LEAF_BLOCKS; ++b)
+    {
+        for (i = 0; i < lanes; ++i)
+        {
+            const unsigned char *const p =
+                &m[(size_t)i * GIMLI_TREE_HASH_LEAF_LEN + b * GIMLI_RATE];
+            for (j = 0; j < GIMLI_RATE / 4; ++j)
+            {
+                s[i][j] ^= gimli_load(&p[j * 4]);
+            }
+        }
+        permute(s);
+    }
+
+    /* LEAF_DOMAIN at offset 0, then the padding byte at offset 1. */
+    for (i = 0; i < lanes; ++i)
+    {
+        s[i][0] ^= LEAF_DOMAIN | (UINT32_C(0x01) << 8);
+        s[i][GIMLI_WORDS - 1] ^= UINT32_C(0x01000000);
+    }
+
+    for (b = 0; b < GIMLI_TREE_HASH_CV_LEN; b += GIMLI_RATE)
+    {
+        permute(s);
+        for (i = 0; i < lanes; ++i)
+        {
+            unsigned char *const cv = &cvs[i * GIMLI_TREE_HASH_CV_LEN + b];
+            for (j = 0; j < GIMLI_RATE / 4; ++j)
+            {
+                gimli_store(&cv[j * 4], s[i][j]);
+            }
+        }
+    }
+}
+
+void gimli_tree_hash_leaves(unsigned char *cvs, const unsigned char *m,
+                            size_t n)
+{
+    for (; n >= 8; n -= 8)
+    {
+        hash_leaves(cvs, m, 8, gimli_x8);
+        cvs += 8 * GIMLI_TREE_HASH_CV_LEN;
+        m += 8 * GIMLI_TREE_HASH_LEAF_LEN;
+    }
+    while (n > 0)
+    {
+        const unsigned lanes = n >= 4 ? 4U : (unsigned)n;
+        hash_leaves(cvs, m, lanes, gimli_x4);
+        cvs += lanes * GIMLI_TREE_HASH_CV_LEN;
+        m += lanes * GIMLI_TREE_HASH_LEAF_LEN;
+        n -= lanes;
+    }
+}
+
+#define BUF_LEAVES (GIMLI_TREE_HASH_BUF_LEN / GIMLI_TREE_HASH_LEAF_LEN)
+
+/*
+ * Hash n whole leaves of m in parallel lanes and absorb their chaining values
+ * into root.
+ */
+static void absorb_leaves(gimli_hash_state *root, uint64_t *leaves,
+                          const unsigned char *m, size_t n)
+{
+    unsigned char cvs[MAX_LANES * GIMLI_TREE_HASH_CV_LEN];
+    while (n > 0)
+    {
+        const size_t k = n < MAX_LANES ? n : MAX_LANES;
+        gimli_tree_hash_leaves(cvs, m, k);
+        gimli_hash_update(root, cvs, k * GIMLI_TREE_HASH_CV_LEN);
+        *leaves += k;
+        m += k * GIMLI_TREE_HASH_LEAF_LEN;
+        n -= k;
+    }
+}
+
+/*
+ * Absorb the last leaf, of len bytes, and output the digest.
+ */
+static void finish(gimli_hash_state *root, uint64_t leaves,
+                   const unsigned char *m, size_t len, unsigned char *h,
+                   size_t hlen)
+{
+    static const unsigned char leaf_domain = LEAF_DOMAIN;
+    static const unsigned char root_domain = ROOT_DOMAIN;
+    gimli_hash_state leaf;
+    unsigned char cv[GIMLI_TREE_HASH_CV_LEN], count[8];
+
+    if (len > 0 || leaves == 0)
+    {
+        gimli_hash_init(&leaf);
+        gimli_hash_update(&leaf, m, len);
+        gimli_hash_update(&leaf, &leaf_domain, 1);
+        gimli_hash_final(&leaf, cv, sizeof cv);
+        gimli_hash_update(root, cv, sizeof cv);
+        ++leaves;
+    }
+    gimli_store(&count[0], (uint32_t)(leaves & UINT32_C(0xFFFFFFFF)));
+    gimli_store(&count[4], (uint32_t)(leaves >> 32));
+    gimli_hash_update(root, count, sizeof count);
+    gimli_hash_update(root, &root_domain, 1);
+    gimli_hash_final(root, h, hlen);
+}
+
+/*
+ * Hash the whole leaves in the buffer, leaving any partial leaf in it.
+ */
+static void flush_whole_leaves(gimli_tree_hash_state *t)
+{
+    const size_t n = t->buf_len / GIMLI_TREE_HASH_LEAF_LEN;
+    const size_t whole = n * GIMLI_TREE_HASH_LEAF_LEN;
+    absorb_leaves(&t->root, &t->leaves, t->buf, n);
+    (void)memmove(t->buf, &t->buf[whole], t->buf_len - whole);
+    t->buf_len -= whole;
+}
+
+void gimli_tree_hash_init(gimli_tree_hash_state *t)
+{
+    gimli_hash_init(&t->root);
+    t->leaves = 0;
+    t->buf_len = 0;
+}
+
+void gimli_tree_hash_update_cvs(gimli_tree_hash_state *t,
+                                const unsigned char *cvs, size_t n)
+{
+    /* The buffer holds whole leaves here, which come before these. */
+    flush_whole_leaves(t);
+    gimli_hash_update(&t->root, cvs, n * GIMLI_TREE_HASH_CV_LEN);
+    t->leaves += n;
+}
+
+void gimli_tree_hash_update(gimli_tree_hash_state *t, const unsigned char *m,
+                            size_t len)
+{
+    size_t n;
+
+    /*
+     * A full buffer is hashed only once more input follows, and whole leaves
+     * are hashed in place only if some input remains after them, so the last
+     * leaf is always in the buffer for gimli_tree_hash_final.
+     */
+    while (len > 0)
+    {
+        if (t->buf_len == GIMLI_TREE_HASH_BUF_LEN)
+        {
+            absorb_leaves(&t->root, &t->leaves, t->buf, BUF_LEAVES);
+            t->buf_len = 0;
+        }
+        if (t->buf_len == 0 && len > GIMLI_TREE_HASH_BUF_LEN)
+        {
+            n = (len - 1) / GIMLI_TREE_HASH_LEAF_LEN;
+            absorb_leaves(&t->root, &t->leaves, m, n);
+            m += n * GIMLI_TREE_HASH_LEAF_LEN;
+            len -= n * GIMLI_TREE_HASH_LEAF_LEN;
+        }
+        n = GIMLI_TREE_HASH_BUF_LEN - t->buf_len;
+        if (n > len)
+        {
+            n = len;
+        }
+        (void)memcpy(&t->buf[t->buf_len], m, n);
+        t->buf_len += n;
+        m += n;
+        len -= n;
+    }
+}
+
+void gimli_tree_hash_final(gimli_tree_hash_state *t, unsigned char *h,
+                           size_t len)
+{
+    /* A whole last leaf is hashed in the lanes with the others. */
+    flush_whole_leaves(t);
+    finish(&t->root, t->leaves, t->buf, t->buf_len, h, len);
+}
+
+void gimli_tree_hash(unsigned char *h, size_t hlen, const unsigned char *m,
+                     size_t mlen)
+{
+    /* Hash the leaves in place, without the buffer of gimli_tree_hash_state. */
+    const size_t n = mlen == 0 ? 0 : (mlen - 1) / GIMLI_TREE_HASH_LEAF_LEN;
+    gimli_hash_state root;
+    uint64_t leaves = 0;
+    gimli_hash_init(&root);
+    absorb_leaves(&root, &leaves, m, n);
+    finish(&root, leaves, &m[n * GIMLI_TREE_HASH_LEAF_LEN],
+           mlen - n * GIMLI_TREE_HASH_LEAF_LEN, h, hlen);
+}
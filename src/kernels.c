@@ -0,0 +1,57 @@
+/*
+ * Part of liblithium, under the Apache License v2.0.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Instantiates the dispatched kernels for one instruction set level. This file
+ * is compiled once per level, with LITH_KERNEL_LEVEL defined to the level name
+ * and the compiler flags for that level. Every external symbol of the included
+ * sources is renamed with the level as a suffix, and dispatch.c refers to the
+ * ones it needs.
+ */
+
+#include "dispatch.h"
+
+#if !defined(LITH_KERNEL_LEVEL)
+#error "LITH_KERNEL_LEVEL must be defined to compile kernels.c"
+#endif
+
+#define gimli LITH_KERNEL_NAME(gimli, LITH_KERNEL_LEVEL)
+#define gimli_x4 LITH_KERNEL_NAME(gimli_x4, LITH_KERNEL_LEVEL)
+#define gimli_x8 LITH_KERNEL_NAME(gimli_x8, LITH_KERNEL_LEVEL)
+#define gimli_absorb_blocks                                                    \
+    LITH_KERNEL_NAME(gimli_absorb_blocks, LITH_KERNEL_LEVEL)
+#define gimli_encrypt_blocks                                                   \
+    LITH_KERNEL_NAME(gimli_encrypt_blocks, LITH_KERNEL_LEVEL)
+#define gimli_decrypt_blocks                                                   \
+    LITH_KERNEL_NAME(gimli_decrypt_blocks, LITH_KERNEL_LEVEL)
+#define gimli_overwrite_blocks                                                 \
+    LITH_KERNEL_NAME(gimli_overwrite_blocks, LITH_KERNEL_LEVEL)
+#define gimli_squeeze_blocks                                                   \
+    LITH_KERNEL_NAME(gimli_squeeze_blocks, LITH_KERNEL_LEVEL)
+
+#define read_limbs LITH_KERNEL_NAME(read_limbs, LITH_KERNEL_LEVEL)
+#define write_limbs LITH_KERNEL_NAME(write_limbs, LITH_KERNEL_LEVEL)
+#define fe_read LITH_KERNEL_NAME(fe_read, LITH_KERNEL_LEVEL)
+#define fe_write LITH_KERNEL_NAME(fe_write, LITH_KERNEL_LEVEL)
+#define add LITH_KERNEL_NAME(add, LITH_KERNEL_LEVEL)
+#define sub LITH_KERNEL_NAME(sub, LITH_KERNEL_LEVEL)
+#define mul LITH_KERNEL_NAME(mul, LITH_KERNEL_LEVEL)
+#define mul1 LITH_KERNEL_NAME(mul1, LITH_KERNEL_LEVEL)
+#define mul_word LITH_KERNEL_NAME(mul_word, LITH_KERNEL_LEVEL)
+#define sqr1 LITH_KERNEL_NAME(sqr1, LITH_KERNEL_LEVEL)
+#define canon LITH_KERNEL_NAME(canon, LITH_KERNEL_LEVEL)
+#define inv LITH_KERNEL_NAME(inv, LITH_KERNEL_LEVEL)
+#define fe_batch_inv LITH_KERNEL_NAME(fe_batch_inv, LITH_KERNEL_LEVEL)
+#define asr LITH_KERNEL_NAME(asr, LITH_KERNEL_LEVEL)
+#define mac LITH_KERNEL_NAME(mac, LITH_KERNEL_LEVEL)
+#define adc LITH_KERNEL_NAME(adc, LITH_KERNEL_LEVEL)
+#define x25519_batch LITH_KERNEL_NAME(x25519_batch, LITH_KERNEL_LEVEL)
+#define ladder_lanes LITH_KERNEL_NAME(ladder_lanes, LITH_KERNEL_LEVEL)
+
+#include "fe.c"
+#include "fe25.c"
+#include "fe51.c"
+#include "gimli.c"
+#include "x25519_batch.c"
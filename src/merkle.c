@@ -0,0 +1,264 @@
+/*
+ * Part of liblithium, under the Apache License v2.0.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <lithium/merkle.h>
+
+#include <lithium/gimli_hash.h>
+
+#include "gimli_common.h"
+
+#include <string.h>
+
+#define HASH_LEN LITH_MERKLE_HASH_LEN
+
+/* Number of messages handed to gimli_hash_many_from at once. */
+#define BATCH 16U
+
+static const char leaf_domain[] = "lith_merkle_leaf";
+static const char node_domain[] = "lith_merkle_node";
+static const char root_domain[] = "lith_merkle_root";
+
+/* Each domain prefix is exactly one block, leaving the state at offset 0. */
+static void domain_state(gimli_state *g, const char *domain)
+{
+    gimli_hash_init(g);
+    gimli_hash_update(g, (const unsigned char *)domain, GIMLI_RATE);
+}
+
+static size_t leaf_count(size_t n)
+{
+    size_t p = 1;
+    while (p < n)
+    {
+        p *= 2;
+    }
+    return p;
+}
+
+static unsigned char *node(const lith_merkle_tree *t, size_t i)
+{
+    return &t->nodes[i * HASH_LEN];
+}
+
+/* The index of the first leaf under node i, of a tree with p leaves. */
+static size_t first_leaf(size_t i, size_t p)
+{
+    while (i < p)
+    {
+        i *= 2;
+    }
+    return i - p;
+}
+
+static void hash_leaf(unsigned char h[HASH_LEN], const unsigned char *chunk,
+                      size_t len)
+{
+    gimli_state g;
+    domain_state(&g, leaf_domain);
+    gimli_hash_update(&g, chunk, len);
+    gimli_hash_final(&g, h, HASH_LEN);
+}
+
+static void hash_node(unsigned char h[HASH_LEN],
+                      const unsigned char left[HASH_LEN],
+                      const unsigned char right[HASH_LEN])
+{
+    gimli_state g;
+    domain_state(&g, node_domain);
+    gimli_hash_update(&g, left, HASH_LEN);
+    gimli_hash_update(&g, right, HASH_LEN);
+    gimli_hash_final(&g, h, HASH_LEN);
+}
+
+static void hash_root(unsigned char root[HASH_LEN], size_t n,
+                      const unsigned char top[HASH_LEN])
+{
+    unsigned char count[8];
+    gimli_state g;
+    size_t i;
+    for (i = 0; i < sizeof count; ++i)
+    {
+        count[i] = (unsigned char)(n & 0xFFU);
+        n >>= 8;
+    }
+    domain_state(&g, root_domain);
+    gimli_hash_update(&g, count, sizeof count);
+    gimli_hash_update(&g, top, HASH_LEN);
+    gimli_hash_final(&g, root, HASH_LEN);
+}
+
+size_t lith_merkle_nodes(size_t n)
+{
+    return 2 * leaf_count(n);
+}
+
+void lith_merkle_init(lith_merkle_tree *t, unsigned char *nodes, size_t n,
+                      size_t chunk_len)
+{
+    t->nodes = nodes;
+    t->n = n;
+    t->leaves = leaf_count(n);
+    t->chunk_len = chunk_len;
+}
+
+bool lith_merkle_hash_chunks(lith_merkle_tree *t, size_t first,
+                             const unsigned char *data, size_t len)
+{
+    const unsigned char *m[BATCH];
+    unsigned char *h[BATCH];
+    size_t mlen[BATCH];
+    gimli_state start;
+
+    if (first > t->n || (len > 0 && t->chunk_len == 0))
+    {
+        return false;
+    }
+    if (len > 0 && (len - 1) / t->chunk_len >= t->n - first)
+    {
+        return false;
+    }
+    domain_state(&start, leaf_domain);
+    while (len > 0)
+    {
+        size_t k;
+        for (k = 0; k < BATCH && len > 0; ++k)
+        {
+            mlen[k] = (len < t->chunk_len) ? len : t->chunk_len;
+            m[k] = data;
+            h[k] = node(t, t->leaves + first + k);
+            data += mlen[k];
+            len -= mlen[k];
+        }
+        gimli_hash_many_from(&start, h, HASH_LEN, m, mlen, k);
+        first += k;
+    }
+    return true;
+}
+
+void lith_merkle_build(lith_merkle_tree *t)
+{
+    const unsigned char *m[BATCH];
+    unsigned char *h[BATCH];
+    size_t mlen[BATCH];
+    gimli_state start;
+    size_t level, i;
+
+    domain_state(&start, node_domain);
+    /* Nodes of one level only depend on the level below. */
+    for (level = t->leaves / 2; level > 0; level /= 2)
+    {
+        size_t k = 0;
+        for (i = level; i < 2 * level; ++i)
+        {
+            if (first_leaf(2 * i + 1, t->leaves) >= t->n)
+            {
+                if (first_leaf(i, t->leaves) < t->n)
+                {
+                    (void)memcpy(node(t, i), node(t, 2 * i), HASH_LEN);
+                }
+                continue;
+            }
+            m[k] = node(t, 2 * i);
+            mlen[k] = 2 * HASH_LEN;
+            h[k] = node(t, i);
+            ++k;
+            if (k == BATCH)
+            {
+                gimli_hash_many_from(&start, h, HASH_LEN, m, mlen, k);
+                k = 0;
+            }
+        }
+        gimli_hash_many_from(&start, h, HASH_LEN, m, mlen, k);
+    }
+    hash_root(node(t, 0), t->n, node(t, 1));
+}
+
+bool lith_merkle_update(lith_merkle_tree *t, size_t i,
+                        const unsigned char *chunk, size_t len)
+{
+    size_t j = t->leaves + i;
+    if (i >= t->n)
+    {
+        return false;
+    }
+    hash_leaf(node(t, j), chunk, len);
+    for (j /= 2; j > 0; j /= 2)
+    {
+        if (first_leaf(2 * j + 1, t->leaves) >= t->n)
+        {
+            (void)memcpy(node(t, j), node(t, 2 * j), HASH_LEN);
+        }
+        else
+        {
+            hash_node(node(t, j), node(t, 2 * j), node(t, 2 * j + 1));
+        }
+    }
+    hash_root(node(t, 0), t->n, node(t, 1));
+    return true;
+}
+
+void lith_merkle_root(const lith_merkle_tree *t,
+                      unsigned char root[LITH_MERKLE_HASH_LEN])
+{
+    (void)memcpy(root, node(t, 0), HASH_LEN);
+}
+
+size_t lith_merkle_proof(const lith_merkle_tree *t, size_t i,
+                         unsigned char *proof)
+{
+    size_t j, len = 0;
+    if (i >= t->n)
+    {
+        return 0;
+    }
+    for (j = t->leaves + i; j > 1; j /= 2)
+    {
+        /* Empty siblings are skipped, since their parent copies this node. */
+        if (first_leaf(j ^ 1, t->leaves) < t->n)
+        {
+            (void)memcpy(&proof[len * HASH_LEN], node(t, j ^ 1), HASH_LEN);
+            ++len;
+        }
+    }
+    return len;
+}
+
+bool lith_merkle_verify(const unsigned char root[LITH_MERKLE_HASH_LEN],
+                        size_t n, size_t i, const unsigned char *chunk,
+                        size_t len, const unsigned char *proof,
+                        size_t proof_len)
+{
+    const size_t p = leaf_count(n);
+    unsigned char h[HASH_LEN], expected[HASH_LEN];
+    size_t j, used = 0;
+
+    if (i >= n)
+    {
+        return false;
+    }
+    hash_leaf(h, chunk, len);
+    for (j = p + i; j > 1; j /= 2)
+    {
+        if (first_leaf(j ^ 1, p) >= n)
+        {
+            continue;
+        }
+        if (used == proof_len)
+        {
+            return false;
+        }
+        if (j % 2 == 0)
+        {
+            hash_node(h, h, &proof[used * HASH_LEN]);
+        }
+        else
+        {
+            hash_node(h, &proof[used * HASH_LEN], h);
+        }
+        ++used;
+    }
+    hash_root(expected, n, h);
+    return used == proof_len && memcmp(expected, root, HASH_LEN) == 0;
+}
@@ -100,6 +100,37 @@
 #define LITH_SHUFFLE_ROL24 1
 #endif
 
+/*
+ * AVX-512VL provides vector rotates and three-input ternary logic operations on
+ * 128-bit vectors, which shorten the dependency chains in each round of the
+ * permutation, so use a dedicated kernel for it.
+ */
+#if !defined(LITH_AVX512VL) && defined(__AVX512VL__)
+#define LITH_AVX512VL 1
+#endif
+
+/*
+ * With 256-bit integer vectors, gimli_x8 can keep each word of all eight
+ * states in one register. Without them, it is faster to permute two groups of
+ * four states than to let the compiler split up wider vectors.
+ */
+#if !defined(LITH_VECTORIZE_X8) && defined(__AVX2__)
+#define LITH_VECTORIZE_X8 1
+#endif
+
+/*
+ * x25519_batch runs one Montgomery ladder in each 64-bit lane of a vector. With
+ * AVX-512 IFMA, eight lanes of 51-bit limbs are multiplied with 52-bit
+ * multiply-adds. With AVX2, four lanes of 26- and 25-bit limbs are multiplied
+ * with 32x32-bit multiplies.
+ */
+#if !defined(LITH_X25519_LANES) && defined(__AVX512IFMA__) &&                  \
+    defined(__AVX512F__)
+#define LITH_X25519_LANES 8
+#elif !defined(LITH_X25519_LANES) && defined(__AVX2__)
+#define LITH_X25519_LANES 4
+#endif
+
 #endif
 #endif
 
@@ -111,6 +142,18 @@
 #define LITH_SPONGE_VECTORS 0
 #endif
 
+#ifndef LITH_AVX512VL
+#define LITH_AVX512VL 0
+#endif
+
+#ifndef LITH_VECTORIZE_X8
+#define LITH_VECTORIZE_X8 0
+#endif
+
+#ifndef LITH_X25519_LANES
+#define LITH_X25519_LANES 1
+#endif
+
 #ifndef LITH_SHUFFLE_ROL24
 #define LITH_SHUFFLE_ROL24 0
 #endif
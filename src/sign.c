@@ -34,6 +34,12 @@ void lith_sign_update(lith_sign_state *state, const unsigned char *msg,
     gimli_hash_update(state, msg, len);
 }
 
+void lith_sign_updatev(lith_sign_state *state, const struct lith_iovec *iov,
+                       size_t n)
+{
+    gimli_hash_updatev(state, iov, n);
+}
+
 static void
 gen_challenge(gimli_hash_state *state, unsigned char challenge[X25519_LEN],
               const unsigned char public_nonce[X25519_LEN],
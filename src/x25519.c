@@ -17,24 +17,24 @@
 #include <string.h>
 
 typedef limb sc[NLIMBS];
-typedef limb feq[NLIMBS * 2];
+typedef fe_limb feq[FE_LIMBS * 2];
 
-static limb *X(feq P)
+static fe_limb *X(feq P)
 {
     return P;
 }
 
-static limb *Z(feq P)
+static fe_limb *Z(feq P)
 {
-    return &P[NLIMBS];
+    return &P[FE_LIMBS];
 }
 
-static void cswap(limb swap, feq P, feq Q)
+static void cswap(fe_limb swap, feq P, feq Q)
 {
     int i;
-    for (i = 0; i < NLIMBS * 2; ++i)
+    for (i = 0; i < FE_LIMBS * 2; ++i)
     {
-        const limb d = (P[i] ^ Q[i]) & swap;
+        const fe_limb d = (P[i] ^ Q[i]) & swap;
         P[i] ^= d;
         Q[i] ^= d;
     }
@@ -47,7 +47,7 @@ static void cswap(limb swap, feq P, feq Q)
 
 static void mul_a24(fe out, const fe a)
 {
-#if (LITH_X25519_WBITS < 32)
+#if (LITH_X25519_RADIX == 0) && (LITH_X25519_WBITS < 32)
     static const fe a24 = {LIMBS(0xDB41, 0x0001, 0x0000, 0x0000)};
     mul(out, a, a24);
 #else
@@ -85,8 +85,12 @@ static void ladder_part2(feq P, feq Q, const fe t, const fe x)
 static void x25519_q(feq P, const unsigned char k[X25519_LEN], const fe x)
 {
     feq Q;
-    limb swap = 0;
+    fe_limb swap = 0;
     int i;
+    if (ladder_lanes(X(P), Z(P), k, x))
+    {
+        return;
+    }
     (void)memcpy(X(Q), x, sizeof(fe));
     (void)memset(Z(Q), 0, sizeof(fe));
     (void)memset(P, 0, sizeof(feq));
@@ -96,7 +100,7 @@ static void x25519_q(feq P, const unsigned char k[X25519_LEN], const fe x)
     for (i = X25519_BITS - 1; i >= 0; --i)
     {
         fe t;
-        const limb kb = (limb)-(int)((k[i / 8] >> (i % 8)) & 1);
+        const fe_limb kb = (fe_limb)-(int)((k[i / 8] >> (i % 8)) & 1);
         cswap(swap ^ kb, P, Q);
         swap = kb;
         ladder_part1(P, Q, t);
@@ -114,7 +118,22 @@ static void feq_to_bytes(unsigned char out[X25519_LEN], feq P)
     inv(Z(P));
     mul1(X(P), Z(P));
     (void)canon(X(P));
-    write_limbs(out, X(P));
+    fe_write(out, X(P));
+}
+
+void clamp(unsigned char k[X25519_LEN], const unsigned char scalar[X25519_LEN])
+{
+    /*
+     * Per RFC7748 section 5:
+     * "For X25519, in order to decode 32 random bytes as an integer scalar,
+     * set the three least significant bits of the first byte and the most
+     * significant bit of the last to zero, set the second most significant bit
+     * of the last byte to 1 and, finally, decode as little-endian."
+     */
+    memcpy(k, scalar, X25519_LEN);
+    k[0] &= 0xF8U;
+    k[X25519_LEN - 1] &= 0x7FU;
+    k[X25519_LEN - 1] |= 0x40U;
 }
 
 void x25519(unsigned char out[X25519_LEN],
@@ -135,21 +154,10 @@ void x25519(unsigned char out[X25519_LEN],
      *
      * Clear this bit after converting to an fe to avoid making an extra copy.
      */
-    read_limbs(x, point);
-    x[NLIMBS - 1] &= ~LIMB_HIGH_BIT_MASK;
-
-    /*
-     * Also per RFC7748 section 5:
-     * "For X25519, in order to decode 32 random bytes as an integer scalar,
-     * set the three least significant bits of the first byte and the most
-     * significant bit of the last to zero, set the second most significant bit
-     * of the last byte to 1 and, finally, decode as little-endian."
-     */
-    memcpy(k, scalar, X25519_LEN);
-    k[0] &= 0xF8U;
-    k[X25519_LEN - 1] &= 0x7FU;
-    k[X25519_LEN - 1] |= 0x40U;
+    fe_read(x, point);
+    x[FE_LIMBS - 1] &= ~FE_HIGH_BIT_MASK;
 
+    clamp(k, scalar);
     x25519_q(P, k, x);
     feq_to_bytes(out, P);
 }
@@ -159,8 +167,14 @@ void x25519(unsigned char out[X25519_LEN],
 void x25519_base(unsigned char out[X25519_LEN],
                  const unsigned char scalar[X25519_LEN])
 {
+#if (LITH_X25519_BASE_TABLE)
+    unsigned char k[X25519_LEN];
+    clamp(k, scalar);
+    x25519_base_uniform(out, k);
+#else
     const unsigned char base_point[X25519_LEN] = {BASE_POINT};
     x25519(out, scalar, base_point);
+#endif
 }
 
 static const sc L = {
@@ -280,8 +294,16 @@ void x25519_base_uniform(unsigned char out[X25519_LEN],
                          const unsigned char scalar[X25519_LEN])
 {
     feq P;
+#if (LITH_X25519_BASE_TABLE)
+    /* The base point has order L, so only the scalar mod L matters. */
+    unsigned char k[X25519_LEN * 2] = {0};
+    (void)memcpy(k, scalar, X25519_LEN);
+    x25519_scalar_reduce(k, k);
+    base_mul(X(P), Z(P), k);
+#else
     fe B = {BASE_POINT};
     x25519_q(P, scalar, B);
+#endif
     feq_to_bytes(out, P);
 }
 
@@ -299,9 +321,23 @@ bool x25519_verify(const unsigned char response[X25519_LEN],
     feq P, Q;
     fe A, B = {BASE_POINT};
 
-    read_limbs(A, public_key);
+    fe_read(A, public_key);
 
+#if (LITH_X25519_FAST_VERIFY)
+    {
+        /*
+         * The check below is homogeneous in x, z and in u, w, so any nonzero
+         * multiple of the ladder's output gives the same decision, including
+         * (x:0) when response is a multiple of L.
+         */
+        unsigned char k[X25519_LEN * 2] = {0};
+        (void)memcpy(k, response, X25519_LEN);
+        x25519_scalar_reduce(k, k);
+        base_mul_vartime(X(P), Z(P), k);
+    }
+#else
     x25519_q(P, response, B);
+#endif
     /* P = x/z = response*base_point */
     x25519_q(Q, challenge, A);
     /* Q = u/w = challenge*public_key */
@@ -315,7 +351,7 @@ bool x25519_verify(const unsigned char response[X25519_LEN],
     /* Z(Q) = 2zu - 2xw */
     /* Z(P) = xx + axz + zz */
 
-    read_limbs(B, public_nonce);
+    fe_read(B, public_nonce);
     /* B = R */
 
     mul1(A, Z(P));
@@ -0,0 +1,260 @@
+/*
+ * Part of liblithium, under the Apache License v2.0.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Fixed-base scalar multiplication with a signed radix-16 comb, as in ref10's
+ * ge_scalarmult_base, on the twisted Edwards curve -x^2 + y^2 = 1 + dx^2y^2
+ * which is birationally equivalent to Curve25519. Its base point B has
+ * Montgomery x-coordinate u = (1 + y)/(1 - y) = 9.
+ *
+ * A scalar k below L is written as 64 digits e_i in [-8, 8] with
+ * k = sum e_i 16^i, so that
+ *
+ * kB = sum e_2i 256^i B + 16 sum e_2i+1 256^i B.
+ *
+ * Each term is looked up in base_table, which holds 1 to 8 times 256^i B, and
+ * every lookup reads all eight entries, so neither the memory accesses nor the
+ * running time depend on k.
+ */
+
+#include "fe.h"
+
+#include <string.h>
+
+#if (LITH_X25519_BASE_TABLE)
+
+/* Extended coordinates: x = X/Z, y = Y/Z, and xy = T/Z. */
+struct ge
+{
+    fe x, y, z, t;
+};
+
+/* An affine point (x, y) as (y + x, y - x, 2dxy). */
+typedef fe niels[3];
+
+/*
+ * The table is written as four 64-bit words per field element, which are split
+ * into the limbs of each representation.
+ */
+#define W16(w, i) ((uint16_t)((UINT64_C(w) >> (16 * (i))) & 0xFFFFU))
+#define W32(w, i) ((uint32_t)((UINT64_C(w) >> (32 * (i))) & 0xFFFFFFFFU))
+#define BITS(x, n) ((x) & ((UINT64_C(1) << (n)) - 1))
+
+#if (LITH_X25519_RADIX == 0) && (LITH_X25519_WBITS == 16)
+#define FE(a, b, c, d)                                                         \
+    {                                                                          \
+        W16(a, 0), W16(a, 1), W16(a, 2), W16(a, 3), W16(b, 0), W16(b, 1),      \
+            W16(b, 2), W16(b, 3), W16(c, 0), W16(c, 1), W16(c, 2), W16(c, 3),  \
+            W16(d, 0), W16(d, 1), W16(d, 2), W16(d, 3)                         \
+    }
+#elif (LITH_X25519_RADIX == 0) && (LITH_X25519_WBITS == 32)
+#define FE(a, b, c, d)                                                         \
+    {                                                                          \
+        W32(a, 0), W32(a, 1), W32(b, 0), W32(b, 1), W32(c, 0), W32(c, 1),      \
+            W32(d, 0), W32(d, 1)                                               \
+    }
+#elif (LITH_X25519_RADIX == 0)
+#define FE(a, b, c, d)                                                         \
+    {                                                                          \
+        UINT64_C(a), UINT64_C(b), UINT64_C(c), UINT64_C(d)                     \
+    }
+#elif (LITH_X25519_RADIX == 51)
+#define FE(a, b, c, d)                                                         \
+    {                                                                          \
+        BITS(UINT64_C(a), 51),                                                 \
+            BITS(UINT64_C(a) >> 51 | UINT64_C(b) << 13, 51),                   \
+            BITS(UINT64_C(b) >> 38 | UINT64_C(c) << 26, 51),                   \
+            BITS(UINT64_C(c) >> 25 | UINT64_C(d) << 39, 51),                   \
+            UINT64_C(d) >> 12                                                  \
+    }
+#elif (LITH_X25519_RADIX == 25)
+#define FE(a, b, c, d)                                                         \
+    {                                                                          \
+        (uint32_t)BITS(UINT64_C(a), 26),                                       \
+            (uint32_t)BITS(UINT64_C(a) >> 26, 25),                             \
+            (uint32_t)BITS(UINT64_C(a) >> 51 | UINT64_C(b) << 13, 26),         \
+            (uint32_t)BITS(UINT64_C(b) >> 13, 25),                             \
+            (uint32_t)BITS(UINT64_C(b) >> 38 | UINT64_C(c) << 26, 26),         \
+            (uint32_t)BITS(UINT64_C(c), 25),                                   \
+            (uint32_t)BITS(UINT64_C(c) >> 25, 26),                             \
+            (uint32_t)BITS(UINT64_C(c) >> 51 | UINT64_C(d) << 13, 25),         \
+            (uint32_t)BITS(UINT64_C(d) >> 12, 26),                             \
+            (uint32_t)(UINT64_C(d) >> 38)                                      \
+    }
+#endif
+
+#include "x25519_base_table.h"
+
+static const fe zero = {0};
+
+static void cmov(fe_limb *out, const fe_limb *in, size_t n, fe_limb mask)
+{
+    size_t i;
+    for (i = 0; i < n; ++i)
+    {
+        out[i] ^= (out[i] ^ in[i]) & mask;
+    }
+}
+
+/*
+ * Set n to d 256^i B, for a digit d in [-8, 8].
+ */
+static void lookup(niels n, int i, int d)
+{
+    const unsigned neg = (unsigned)d >> (sizeof d * CHAR_BIT - 1);
+    const unsigned mag = ((unsigned)d ^ (0U - neg)) + neg;
+    const fe_limb negate = (fe_limb)0 - (fe_limb)neg;
+    fe t;
+    int j;
+
+    /* The identity is (0, 1), which is (1, 1, 0). */
+    (void)memset(n, 0, sizeof(niels));
+    n[0][0] = 1;
+    n[1][0] = 1;
+    for (j = 0; j < 8; ++j)
+    {
+        /* mag ^ (j + 1) is below 16, so subtracting 1 wraps only if it is 0. */
+        const fe_limb eq = (fe_limb)0 - (fe_limb)(((mag ^ (unsigned)(j + 1)) -
+                                                   1U) >>
+                                                  (sizeof mag * CHAR_BIT - 1));
+        cmov(n[0], base_table[i][j][0], FE_LIMBS * 3, eq);
+    }
+
+    /* -(x, y) = (-x, y), which swaps y + x with y - x and negates 2dxy. */
+    (void)memcpy(t, n[0], sizeof t);
+    cmov(n[0], n[1], FE_LIMBS, negate);
+    cmov(n[1], t, FE_LIMBS, negate);
+    sub(t, zero, n[2]);
+    cmov(n[2], t, FE_LIMBS, negate);
+}
+
+/*
+ * Add the affine point (ypx, ymx, xy2d) = (y + x, y - x, 2dxy) to p, with the
+ * unified formulas of "Twisted Edwards Curves Revisited" for a = -1.
+ */
+static void add_niels(struct ge *p, const fe ypx, const fe ymx,
+                      const fe xy2d)
+{
+    fe a, b, c, d;
+    sub(a, p->y, p->x);
+    add(b, p->y, p->x);
+    mul1(a, ymx);           /* A = (y1 - x1)(y2 - x2) */
+    mul1(b, ypx);           /* B = (y1 + x1)(y2 + x2) */
+    mul(c, p->t, xy2d);     /* C = t1 2d x2 y2 */
+    mul_word(d, p->z, 2);   /* D = 2 z1 */
+    sub(p->x, b, a);        /* E = B - A */
+    add(p->y, b, a);        /* H = B + A */
+    sub(p->z, d, c);        /* F = D - C */
+    add(p->t, d, c);        /* G = D + C */
+    mul(a, p->x, p->z);     /* x3 = EF */
+    mul(b, p->t, p->y);     /* y3 = GH */
+    mul(c, p->x, p->y);     /* t3 = EH */
+    mul(p->z, p->z, p->t);  /* z3 = FG */
+    (void)memcpy(p->x, a, sizeof(fe));
+    (void)memcpy(p->y, b, sizeof(fe));
+    (void)memcpy(p->t, c, sizeof(fe));
+}
+
+static void dbl(struct ge *p)
+{
+    fe a, b, c, e;
+    (void)memcpy(a, p->x, sizeof(fe));
+    (void)memcpy(b, p->y, sizeof(fe));
+    (void)memcpy(c, p->z, sizeof(fe));
+    sqr1(a);                /* A = x^2 */
+    sqr1(b);                /* B = y^2 */
+    sqr1(c);
+    mul_word(c, c, 2);      /* C = 2z^2 */
+    add(e, p->x, p->y);
+    sqr1(e);
+    sub(e, e, a);
+    sub(e, e, b);           /* E = (x + y)^2 - A - B */
+    sub(p->y, b, a);        /* G = B - A */
+    sub(p->z, p->y, c);     /* F = G - C */
+    sub(c, zero, a);
+    sub(p->t, c, b);        /* H = -A - B */
+    mul(p->x, e, p->z);     /* x3 = EF */
+    mul(p->z, p->z, p->y);  /* z3 = FG */
+    mul(p->y, p->y, p->t);  /* y3 = GH */
+    mul(p->t, e, p->t);     /* t3 = EH */
+}
+
+/*
+ * Add d 256^i B to p. Without vartime, every entry of row i is read; with it,
+ * d is public, so only its own entry is read and a zero digit is skipped.
+ */
+static void add_digit(struct ge *p, int i, int d, bool vartime)
+{
+    niels n;
+    if (!vartime)
+    {
+        lookup(n, i, d);
+        add_niels(p, n[0], n[1], n[2]);
+    }
+    else if (d > 0)
+    {
+        add_niels(p, base_table[i][d - 1][0], base_table[i][d - 1][1],
+                  base_table[i][d - 1][2]);
+    }
+    else if (d < 0)
+    {
+        /* -(x, y) = (-x, y), as in lookup. */
+        sub(n[2], zero, base_table[i][-d - 1][2]);
+        add_niels(p, base_table[i][-d - 1][1], base_table[i][-d - 1][0],
+                  n[2]);
+    }
+}
+
+static void comb(fe u, fe w, const unsigned char k[X25519_LEN], bool vartime)
+{
+    struct ge p;
+    int e[2 * X25519_LEN], carry = 0, i;
+
+    for (i = 0; i < X25519_LEN; ++i)
+    {
+        e[2 * i] = k[i] & 15;
+        e[2 * i + 1] = k[i] >> 4;
+    }
+    /* Move each digit into [-8, 8). k < 2^253, so the top one stays small. */
+    for (i = 0; i < 2 * X25519_LEN - 1; ++i)
+    {
+        e[i] += carry;
+        carry = (e[i] + 8) >> 4;
+        e[i] -= carry * 16;
+    }
+    e[2 * X25519_LEN - 1] += carry;
+
+    (void)memset(&p, 0, sizeof p);
+    p.y[0] = 1;
+    p.z[0] = 1;
+    for (i = 1; i < 2 * X25519_LEN; i += 2)
+    {
+        add_digit(&p, i / 2, e[i], vartime);
+    }
+    dbl(&p);
+    dbl(&p);
+    dbl(&p);
+    dbl(&p);
+    for (i = 0; i < 2 * X25519_LEN; i += 2)
+    {
+        add_digit(&p, i / 2, e[i], vartime);
+    }
+
+    /* u = (1 + y)/(1 - y) = (z + y)/(z - y) */
+    add(u, p.z, p.y);
+    sub(w, p.z, p.y);
+}
+
+void base_mul(fe u, fe w, const unsigned char k[X25519_LEN])
+{
+    comb(u, w, k, false);
+}
+
+void base_mul_vartime(fe u, fe w, const unsigned char k[X25519_LEN])
+{
+    comb(u, w, k, true);
+}
+
+#endif /* LITH_X25519_BASE_TABLE */
@@ -0,0 +1,755 @@
+/*
+ * Part of liblithium, under the Apache License v2.0.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <lithium/watchdog.h>
+#include <lithium/x25519.h>
+
+#include "fe.h"
+#include "opt.h"
+
+#include <string.h>
+
+#if (LITH_X25519_LANES > 1)
+
+#include <immintrin.h>
+
+/*
+ * One Montgomery ladder runs in each 64-bit lane, so every limb of a field
+ * element is a vector holding that limb for each ladder. The ladders only
+ * differ in their scalar bits, which select the swaps lane by lane.
+ */
+typedef uint64_t lanes __attribute__((vector_size(LITH_X25519_LANES * 8)));
+
+#if (LITH_X25519_LANES == 8)
+
+/*
+ * Eight lanes of five 51-bit limbs, multiplied with AVX-512 IFMA. vpmadd52luq
+ * and vpmadd52huq add the low and high 52 bits of the 104-bit product of two
+ * 52-bit limbs, so every multiplier input must be below 2^52, and each carry
+ * leaves the limbs at most 2^51. The high halves have weight 2^52 = 2 * 2^51,
+ * so they are doubled into the next column.
+ */
+#define VLIMBS 5
+#define LMASK51 ((UINT64_C(1) << 51) - 1)
+
+#define VMADD52(l, h, x, y)                                                    \
+    ((l) = (lanes)_mm512_madd52lo_epu64((__m512i)(l), (__m512i)(x),            \
+                                        (__m512i)(y)),                         \
+     (h) = (lanes)_mm512_madd52hi_epu64((__m512i)(h), (__m512i)(x),            \
+                                        (__m512i)(y)))
+
+#define TIMES19(x) ((x) + ((x) << 1) + ((x) << 4))
+
+typedef lanes fev[VLIMBS];
+
+/*
+ * Carry column sums below 2^61 into out.
+ */
+static void fev_carry(fev out, lanes r0, lanes r1, lanes r2, lanes r3,
+                      lanes r4)
+{
+    lanes c;
+    r1 += r0 >> 51;
+    r2 += r1 >> 51;
+    r3 += r2 >> 51;
+    r4 += r3 >> 51;
+    c = (r0 & LMASK51) + TIMES19(r4 >> 51);
+    out[0] = c & LMASK51;
+    out[1] = (r1 & LMASK51) + (c >> 51);
+    out[2] = r2 & LMASK51;
+    out[3] = r3 & LMASK51;
+    out[4] = r4 & LMASK51;
+}
+
+/*
+ * Combine the low and high product halves of columns 0 to 8, and wrap columns
+ * 5 to 9 around multiplied by 19.
+ */
+static void fev_reduce(fev out, const lanes l[9], const lanes h[9])
+{
+    const lanes c5 = l[5] + h[4] + h[4], c6 = l[6] + h[5] + h[5],
+                c7 = l[7] + h[6] + h[6], c8 = l[8] + h[7] + h[7],
+                c9 = h[8] + h[8];
+    fev_carry(out, l[0] + TIMES19(c5), l[1] + h[0] + h[0] + TIMES19(c6),
+              l[2] + h[1] + h[1] + TIMES19(c7),
+              l[3] + h[2] + h[2] + TIMES19(c8),
+              l[4] + h[3] + h[3] + TIMES19(c9));
+}
+
+/* The IFMA multipliers only see 52 bits, so additions carry too. */
+static void fev_add(fev out, const fev a, const fev b)
+{
+    fev_carry(out, a[0] + b[0], a[1] + b[1], a[2] + b[2], a[3] + b[3],
+              a[4] + b[4]);
+}
+
+static void fev_sub(fev out, const fev a, const fev b)
+{
+    /* Add 4p so no limb goes negative. */
+    fev_carry(out, a[0] + UINT64_C(0x1FFFFFFFFFFFB4) - b[0],
+              a[1] + UINT64_C(0x1FFFFFFFFFFFFC) - b[1],
+              a[2] + UINT64_C(0x1FFFFFFFFFFFFC) - b[2],
+              a[3] + UINT64_C(0x1FFFFFFFFFFFFC) - b[3],
+              a[4] + UINT64_C(0x1FFFFFFFFFFFFC) - b[4]);
+}
+
+/*
+ * Subtract b in the lanes set in neg, and add it in the others. With neg set,
+ * b ^ neg + 1 = -b, and 4p is added as in fev_sub.
+ */
+static void fev_addsub(fev out, const fev a, const fev b, lanes neg)
+{
+    fev_carry(out, a[0] + (b[0] ^ neg) + (neg & UINT64_C(0x1FFFFFFFFFFFB5)),
+              a[1] + (b[1] ^ neg) + (neg & UINT64_C(0x1FFFFFFFFFFFFD)),
+              a[2] + (b[2] ^ neg) + (neg & UINT64_C(0x1FFFFFFFFFFFFD)),
+              a[3] + (b[3] ^ neg) + (neg & UINT64_C(0x1FFFFFFFFFFFFD)),
+              a[4] + (b[4] ^ neg) + (neg & UINT64_C(0x1FFFFFFFFFFFFD)));
+}
+
+static void fev_mul(fev out, const fev a, const fev b)
+{
+    lanes l[9] = {0}, h[9] = {0};
+    VMADD52(l[0], h[0], a[0], b[0]);
+    VMADD52(l[1], h[1], a[0], b[1]);
+    VMADD52(l[1], h[1], a[1], b[0]);
+    VMADD52(l[2], h[2], a[0], b[2]);
+    VMADD52(l[2], h[2], a[1], b[1]);
+    VMADD52(l[2], h[2], a[2], b[0]);
+    VMADD52(l[3], h[3], a[0], b[3]);
+    VMADD52(l[3], h[3], a[1], b[2]);
+    VMADD52(l[3], h[3], a[2], b[1]);
+    VMADD52(l[3], h[3], a[3], b[0]);
+    VMADD52(l[4], h[4], a[0], b[4]);
+    VMADD52(l[4], h[4], a[1], b[3]);
+    VMADD52(l[4], h[4], a[2], b[2]);
+    VMADD52(l[4], h[4], a[3], b[1]);
+    VMADD52(l[4], h[4], a[4], b[0]);
+    VMADD52(l[5], h[5], a[1], b[4]);
+    VMADD52(l[5], h[5], a[2], b[3]);
+    VMADD52(l[5], h[5], a[3], b[2]);
+    VMADD52(l[5], h[5], a[4], b[1]);
+    VMADD52(l[6], h[6], a[2], b[4]);
+    VMADD52(l[6], h[6], a[3], b[3]);
+    VMADD52(l[6], h[6], a[4], b[2]);
+    VMADD52(l[7], h[7], a[3], b[4]);
+    VMADD52(l[7], h[7], a[4], b[3]);
+    VMADD52(l[8], h[8], a[4], b[4]);
+    fev_reduce(out, l, h);
+}
+
+/*
+ * The ten cross products are summed once and doubled before the squares are
+ * added.
+ */
+static void fev_sqr(fev a)
+{
+    lanes l[9] = {0}, h[9] = {0};
+    int i;
+    VMADD52(l[1], h[1], a[0], a[1]);
+    VMADD52(l[2], h[2], a[0], a[2]);
+    VMADD52(l[3], h[3], a[0], a[3]);
+    VMADD52(l[3], h[3], a[1], a[2]);
+    VMADD52(l[4], h[4], a[0], a[4]);
+    VMADD52(l[4], h[4], a[1], a[3]);
+    VMADD52(l[5], h[5], a[1], a[4]);
+    VMADD52(l[5], h[5], a[2], a[3]);
+    VMADD52(l[6], h[6], a[2], a[4]);
+    VMADD52(l[7], h[7], a[3], a[4]);
+    for (i = 0; i < 9; ++i)
+    {
+        l[i] += l[i];
+        h[i] += h[i];
+    }
+    VMADD52(l[0], h[0], a[0], a[0]);
+    VMADD52(l[2], h[2], a[1], a[1]);
+    VMADD52(l[4], h[4], a[2], a[2]);
+    VMADD52(l[6], h[6], a[3], a[3]);
+    VMADD52(l[8], h[8], a[4], a[4]);
+    fev_reduce(a, l, h);
+}
+
+/*
+ * Multiply each lane by a word below 2^25. Each product has one column, so the
+ * high halves go straight into the next column without the zeroed arrays of
+ * fev_reduce.
+ */
+static void fev_mul_word(fev out, const fev a, lanes w)
+{
+    const lanes zero = {0};
+    lanes l[VLIMBS], h[VLIMBS];
+    int i;
+    for (i = 0; i < VLIMBS; ++i)
+    {
+        l[i] = zero;
+        h[i] = zero;
+        VMADD52(l[i], h[i], a[i], w);
+    }
+    fev_carry(out, l[0] + TIMES19(h[4] + h[4]), l[1] + h[0] + h[0],
+              l[2] + h[1] + h[1], l[3] + h[2] + h[2], l[4] + h[3] + h[3]);
+}
+
+static void fev_set_lane(fev x, int lane, const unsigned char in[X25519_LEN])
+{
+    uint64_t w[4];
+    int i;
+    for (i = 0; i < 4; ++i)
+    {
+        int j;
+        w[i] = 0;
+        for (j = 7; j >= 0; --j)
+        {
+            w[i] = (w[i] << 8) | in[i * 8 + j];
+        }
+    }
+    x[0][lane] = w[0] & LMASK51;
+    x[1][lane] = ((w[0] >> 51) | (w[1] << 13)) & LMASK51;
+    x[2][lane] = ((w[1] >> 38) | (w[2] << 26)) & LMASK51;
+    x[3][lane] = ((w[2] >> 25) | (w[3] << 39)) & LMASK51;
+    /* Mask the top bit, per RFC7748. */
+    x[4][lane] = (w[3] >> 12) & LMASK51;
+}
+
+/*
+ * Write one lane of x as 32 bytes, reduced below 2^256 but not canonical.
+ */
+static void fev_get_lane(unsigned char out[X25519_LEN], const fev x, int lane)
+{
+    uint64_t v[VLIMBS], w[4];
+    int i;
+    for (i = 0; i < VLIMBS; ++i)
+    {
+        v[i] = x[i][lane];
+    }
+    for (i = 0; i < VLIMBS - 1; ++i)
+    {
+        v[i + 1] += v[i] >> 51;
+        v[i] &= LMASK51;
+    }
+    w[0] = v[0] | (v[1] << 51);
+    w[1] = (v[1] >> 13) | (v[2] << 38);
+    w[2] = (v[2] >> 26) | (v[3] << 25);
+    w[3] = (v[3] >> 39) | (v[4] << 12);
+    for (i = 0; i < X25519_LEN; ++i)
+    {
+        out[i] = (unsigned char)((w[i / 8] >> (i % 8 * 8)) & 0xFFU);
+    }
+}
+
+#elif (LITH_X25519_LANES == 4)
+
+/*
+ * Four lanes of ten limbs in radix 2^25.5, as in fe25.c, multiplied with the
+ * 32x32-bit vpmuludq of AVX2.
+ */
+#define VLIMBS 10
+#define LMASK25 ((UINT64_C(1) << 25) - 1)
+#define LMASK26 ((UINT64_C(1) << 26) - 1)
+
+#define VMUL(x, y) ((lanes)_mm256_mul_epu32((__m256i)(x), (__m256i)(y)))
+
+typedef lanes fev[VLIMBS];
+
+/*
+ * Carry column sums into out, in two interleaved chains, as fe25.c does.
+ */
+static void fev_carry(fev out, lanes r[VLIMBS])
+{
+    lanes c;
+    r[1] += r[0] >> 26;
+    r[6] += r[5] >> 25;
+    r[2] += r[1] >> 25;
+    r[7] += r[6] >> 26;
+    r[3] += r[2] >> 26;
+    r[8] += r[7] >> 25;
+    r[4] += r[3] >> 25;
+    r[9] += r[8] >> 26;
+    r[5] = (r[5] & LMASK25) + (r[4] >> 26);
+    c = r[9] >> 25;
+    r[0] = (r[0] & LMASK26) + c + (c << 1) + (c << 4);
+    r[6] = (r[6] & LMASK26) + (r[5] >> 25);
+    r[1] = (r[1] & LMASK25) + (r[0] >> 26);
+    out[0] = r[0] & LMASK26;
+    out[1] = r[1];
+    out[2] = r[2] & LMASK26;
+    out[3] = r[3] & LMASK25;
+    out[4] = r[4] & LMASK26;
+    out[5] = r[5] & LMASK25;
+    out[6] = r[6];
+    out[7] = r[7] & LMASK25;
+    out[8] = r[8] & LMASK26;
+    out[9] = r[9] & LMASK25;
+}
+
+static void fev_add(fev out, const fev a, const fev b)
+{
+    int i;
+    for (i = 0; i < VLIMBS; ++i)
+    {
+        out[i] = a[i] + b[i];
+    }
+}
+
+static void fev_sub(fev out, const fev a, const fev b)
+{
+    /* Add 4p so no limb goes negative. */
+    lanes r[VLIMBS];
+    int i;
+    r[0] = a[0] + UINT64_C(0xFFFFFB4) - b[0];
+    for (i = 1; i < VLIMBS; ++i)
+    {
+        r[i] = a[i] + ((i & 1) ? UINT64_C(0x7FFFFFC) : UINT64_C(0xFFFFFFC)) -
+               b[i];
+    }
+    fev_carry(out, r);
+}
+
+/*
+ * Subtract b in the lanes set in neg, and add it in the others. With neg set,
+ * b ^ neg + 1 = -b, and 4p is added as in fev_sub.
+ */
+static void fev_addsub(fev out, const fev a, const fev b, lanes neg)
+{
+    lanes r[VLIMBS];
+    int i;
+    r[0] = a[0] + (b[0] ^ neg) + (neg & UINT64_C(0xFFFFFB5));
+    for (i = 1; i < VLIMBS; ++i)
+    {
+        r[i] = a[i] + (b[i] ^ neg) +
+               (neg & ((i & 1) ? UINT64_C(0x7FFFFFD) : UINT64_C(0xFFFFFFD)));
+    }
+    fev_carry(out, r);
+}
+
+static void fev_mul(fev out, const fev a, const fev b)
+{
+    const lanes v19 = (lanes)_mm256_set1_epi64x(19);
+    const lanes a0 = a[0], a1 = a[1], a2 = a[2], a3 = a[3], a4 = a[4],
+                a5 = a[5], a6 = a[6], a7 = a[7], a8 = a[8], a9 = a[9];
+    const lanes b0 = b[0], b1 = b[1], b2 = b[2], b3 = b[3], b4 = b[4],
+                b5 = b[5], b6 = b[6], b7 = b[7], b8 = b[8], b9 = b[9];
+    const lanes a1_2 = a1 + a1, a3_2 = a3 + a3, a5_2 = a5 + a5, a7_2 = a7 + a7,
+                a9_2 = a9 + a9;
+    const lanes b1_19 = VMUL(b1, v19), b2_19 = VMUL(b2, v19),
+                b3_19 = VMUL(b3, v19), b4_19 = VMUL(b4, v19),
+                b5_19 = VMUL(b5, v19), b6_19 = VMUL(b6, v19),
+                b7_19 = VMUL(b7, v19), b8_19 = VMUL(b8, v19),
+                b9_19 = VMUL(b9, v19);
+    lanes r[VLIMBS];
+    r[0] = VMUL(a0, b0) + VMUL(a1_2, b9_19) + VMUL(a2, b8_19) +
+           VMUL(a3_2, b7_19) + VMUL(a4, b6_19) + VMUL(a5_2, b5_19) +
+           VMUL(a6, b4_19) + VMUL(a7_2, b3_19) + VMUL(a8, b2_19) +
+           VMUL(a9_2, b1_19);
+    r[1] = VMUL(a0, b1) + VMUL(a1, b0) + VMUL(a2, b9_19) + VMUL(a3, b8_19) +
+           VMUL(a4, b7_19) + VMUL(a5, b6_19) + VMUL(a6, b5_19) +
+           VMUL(a7, b4_19) + VMUL(a8, b3_19) + VMUL(a9, b2_19);
+    r[2] = VMUL(a0, b2) + VMUL(a1_2, b1) + VMUL(a2, b0) + VMUL(a3_2, b9_19) +
+           VMUL(a4, b8_19) + VMUL(a5_2, b7_19) + VMUL(a6, b6_19) +
+           VMUL(a7_2, b5_19) + VMUL(a8, b4_19) + VMUL(a9_2, b3_19);
+    r[3] = VMUL(a0, b3) + VMUL(a1, b2) + VMUL(a2, b1) + VMUL(a3, b0) +
+           VMUL(a4, b9_19) + VMUL(a5, b8_19) + VMUL(a6, b7_19) +
+           VMUL(a7, b6_19) + VMUL(a8, b5_19) + VMUL(a9, b4_19);
+    r[4] = VMUL(a0, b4) + VMUL(a1_2, b3) + VMUL(a2, b2) + VMUL(a3_2, b1) +
+           VMUL(a4, b0) + VMUL(a5_2, b9_19) + VMUL(a6, b8_19) +
+           VMUL(a7_2, b7_19) + VMUL(a8, b6_19) + VMUL(a9_2, b5_19);
+    r[5] = VMUL(a0, b5) + VMUL(a1, b4) + VMUL(a2, b3) + VMUL(a3, b2) +
+           VMUL(a4, b1) + VMUL(a5, b0) + VMUL(a6, b9_19) + VMUL(a7, b8_19) +
+           VMUL(a8, b7_19) + VMUL(a9, b6_19);
+    r[6] = VMUL(a0, b6) + VMUL(a1_2, b5) + VMUL(a2, b4) + VMUL(a3_2, b3) +
+           VMUL(a4, b2) + VMUL(a5_2, b1) + VMUL(a6, b0) + VMUL(a7_2, b9_19) +
+           VMUL(a8, b8_19) + VMUL(a9_2, b7_19);
+    r[7] = VMUL(a0, b7) + VMUL(a1, b6) + VMUL(a2, b5) + VMUL(a3, b4) +
+           VMUL(a4, b3) + VMUL(a5, b2) + VMUL(a6, b1) + VMUL(a7, b0) +
+           VMUL(a8, b9_19) + VMUL(a9, b8_19);
+    r[8] = VMUL(a0, b8) + VMUL(a1_2, b7) + VMUL(a2, b6) + VMUL(a3_2, b5) +
+           VMUL(a4, b4) + VMUL(a5_2, b3) + VMUL(a6, b2) + VMUL(a7_2, b1) +
+           VMUL(a8, b0) + VMUL(a9_2, b9_19);
+    r[9] = VMUL(a0, b9) + VMUL(a1, b8) + VMUL(a2, b7) + VMUL(a3, b6) +
+           VMUL(a4, b5) + VMUL(a5, b4) + VMUL(a6, b3) + VMUL(a7, b2) +
+           VMUL(a8, b1) + VMUL(a9, b0);
+    fev_carry(out, r);
+}
+
+static void fev_sqr(fev a)
+{
+    const lanes v19 = (lanes)_mm256_set1_epi64x(19);
+    const lanes a0 = a[0], a1 = a[1], a2 = a[2], a3 = a[3], a4 = a[4],
+                a5 = a[5], a6 = a[6], a7 = a[7], a8 = a[8], a9 = a[9];
+    const lanes a0_2 = a0 + a0, a1_2 = a1 + a1, a2_2 = a2 + a2, a3_2 = a3 + a3,
+                a4_2 = a4 + a4, a5_2 = a5 + a5, a6_2 = a6 + a6, a7_2 = a7 + a7,
+                a8_2 = a8 + a8, a9_2 = a9 + a9;
+    const lanes a1_4 = a1_2 + a1_2, a3_4 = a3_2 + a3_2, a5_4 = a5_2 + a5_2,
+                a7_4 = a7_2 + a7_2;
+    const lanes a5_19 = VMUL(a5, v19), a6_19 = VMUL(a6, v19),
+                a7_19 = VMUL(a7, v19), a8_19 = VMUL(a8, v19),
+                a9_19 = VMUL(a9, v19);
+    lanes r[VLIMBS];
+    r[0] = VMUL(a0, a0) + VMUL(a1_4, a9_19) + VMUL(a2_2, a8_19) +
+           VMUL(a3_4, a7_19) + VMUL(a4_2, a6_19) + VMUL(a5_2, a5_19);
+    r[1] = VMUL(a0_2, a1) + VMUL(a2_2, a9_19) + VMUL(a3_2, a8_19) +
+           VMUL(a4_2, a7_19) + VMUL(a5_2, a6_19);
+    r[2] = VMUL(a0_2, a2) + VMUL(a1_2, a1) + VMUL(a3_4, a9_19) +
+           VMUL(a4_2, a8_19) + VMUL(a5_4, a7_19) + VMUL(a6, a6_19);
+    r[3] = VMUL(a0_2, a3) + VMUL(a1_2, a2) + VMUL(a4_2, a9_19) +
+           VMUL(a5_2, a8_19) + VMUL(a6_2, a7_19);
+    r[4] = VMUL(a0_2, a4) + VMUL(a1_4, a3) + VMUL(a2, a2) + VMUL(a5_4, a9_19) +
+           VMUL(a6_2, a8_19) + VMUL(a7_2, a7_19);
+    r[5] = VMUL(a0_2, a5) + VMUL(a1_2, a4) + VMUL(a2_2, a3) +
+           VMUL(a6_2, a9_19) + VMUL(a7_2, a8_19);
+    r[6] = VMUL(a0_2, a6) + VMUL(a1_4, a5) + VMUL(a2_2, a4) + VMUL(a3_2, a3) +
+           VMUL(a7_4, a9_19) + VMUL(a8, a8_19);
+    r[7] = VMUL(a0_2, a7) + VMUL(a1_2, a6) + VMUL(a2_2, a5) + VMUL(a3_2, a4) +
+           VMUL(a8_2, a9_19);
+    r[8] = VMUL(a0_2, a8) + VMUL(a1_4, a7) + VMUL(a2_2, a6) + VMUL(a3_4, a5) +
+           VMUL(a4, a4) + VMUL(a9_2, a9_19);
+    r[9] = VMUL(a0_2, a9) + VMUL(a1_2, a8) + VMUL(a2_2, a7) + VMUL(a3_2, a6) +
+           VMUL(a4_2, a5);
+    fev_carry(a, r);
+}
+
+/*
+ * Multiply each lane by a word below 2^25.
+ */
+static void fev_mul_word(fev out, const fev a, lanes w)
+{
+    lanes r[VLIMBS];
+    int i;
+    for (i = 0; i < VLIMBS; ++i)
+    {
+        r[i] = VMUL(a[i], w);
+    }
+    fev_carry(out, r);
+}
+
+static unsigned limb_offset(int i)
+{
+    return (unsigned)((i * 51 + 1) / 2);
+}
+
+static void fev_set_lane(fev x, int lane, const unsigned char in[X25519_LEN])
+{
+    int i;
+    for (i = 0; i < VLIMBS; ++i)
+    {
+        const unsigned off = limb_offset(i), width = (i & 1) ? 25 : 26;
+        uint64_t v = 0;
+        int j;
+        for (j = (int)(off + width - 1) / 8; j >= (int)off / 8; --j)
+        {
+            v = (v << 8) | in[j];
+        }
+        /* For the top limb, this also masks the top bit, per RFC7748. */
+        x[i][lane] = (v >> (off % 8)) & ((UINT64_C(1) << width) - 1);
+    }
+}
+
+/*
+ * Write one lane of x as 32 bytes, reduced below 2^256 but not canonical.
+ */
+static void fev_get_lane(unsigned char out[X25519_LEN], const fev x, int lane)
+{
+    uint64_t v[VLIMBS], acc = 0;
+    unsigned bits = 0;
+    int i, n = 0;
+    for (i = 0; i < VLIMBS; ++i)
+    {
+        v[i] = x[i][lane];
+    }
+    for (i = 0; i < VLIMBS - 1; ++i)
+    {
+        const unsigned width = (i & 1) ? 25 : 26;
+        v[i + 1] += v[i] >> width;
+        v[i] &= (UINT64_C(1) << width) - 1;
+    }
+    for (i = 0; i < VLIMBS; ++i)
+    {
+        acc |= v[i] << bits;
+        bits += (i & 1) ? 25 : 26;
+        while (bits >= 8)
+        {
+            out[n++] = (unsigned char)(acc & 0xFFU);
+            acc >>= 8;
+            bits -= 8;
+        }
+    }
+    /* The last byte also holds any carry into bit 255. */
+    out[n] = (unsigned char)(acc & 0xFFU);
+}
+
+#else
+#error "LITH_X25519_LANES must be 1, 4, or 8"
+#endif
+
+static void fev_cswap(lanes swap, fev p, fev q)
+{
+    int i;
+    for (i = 0; i < VLIMBS; ++i)
+    {
+        const lanes d = (p[i] ^ q[i]) & swap;
+        p[i] ^= d;
+        q[i] ^= d;
+    }
+}
+
+/*
+ * Run a Montgomery ladder in each lane, as x25519_q does, leaving the
+ * projective result in x2 and z2.
+ */
+static void ladder(fev x2, fev z2, unsigned char k[][X25519_LEN], const fev x1)
+{
+    fev x3, z3, a, b, da, cb;
+    lanes swap = {0}, a24 = {0};
+    int i, lane;
+    (void)memcpy(x3, x1, sizeof(fev));
+    (void)memset(x2, 0, sizeof(fev));
+    (void)memset(z2, 0, sizeof(fev));
+    (void)memset(z3, 0, sizeof(fev));
+    x2[0] += 1;
+    z3[0] += 1;
+    a24 += 121665;
+
+    for (i = X25519_BITS - 1; i >= 0; --i)
+    {
+        lanes kb;
+        for (lane = 0; lane < LITH_X25519_LANES; ++lane)
+        {
+            kb[lane] = (uint64_t)0 - ((k[lane][i / 8] >> (i % 8)) & 1U);
+        }
+        fev_cswap(swap ^ kb, x2, x3);
+        fev_cswap(swap ^ kb, z2, z3);
+        swap = kb;
+
+        fev_add(a, x2, z2);       /* A = x2 + z2 */
+        fev_sub(b, x2, z2);       /* B = x2 - z2 */
+        fev_add(x2, x3, z3);      /* C = x3 + z3 */
+        fev_sub(z2, x3, z3);      /* D = x3 - z3 */
+        fev_mul(da, z2, a);       /* DA */
+        fev_mul(cb, x2, b);       /* CB */
+        fev_add(x3, da, cb);      /* DA + CB */
+        fev_sub(z3, da, cb);      /* DA - CB */
+        fev_sqr(x3);              /* x3 = (DA + CB)^2 */
+        fev_sqr(z3);              /* (DA - CB)^2 */
+        fev_mul(z3, z3, x1);      /* z3 = x1(DA - CB)^2 */
+        fev_sqr(a);               /* AA */
+        fev_sqr(b);               /* BB */
+        fev_mul(x2, a, b);        /* x2 = AA * BB */
+        fev_sub(b, a, b);         /* E = AA - BB */
+        fev_mul_word(z2, b, a24); /* E(a - 2)/4 */
+        fev_add(z2, z2, a);       /* AA + E(a - 2)/4 */
+        fev_mul(z2, z2, b);       /* z2 = E(AA + E(a - 2)/4) */
+#if (LITH_ENABLE_WATCHDOG)
+        lith_watchdog_pet();
+#endif
+    }
+
+    fev_cswap(swap, x2, x3);
+    fev_cswap(swap, z2, z3);
+}
+
+/*
+ * A single ladder runs in lanes 0 to 3, and eight-lane vectors hold a second
+ * copy of it in lanes 4 to 7, so the lane masks and permutations repeat.
+ */
+#if (LITH_X25519_LANES == 8)
+#define LANES4(a, b, c, d)                                                     \
+    {                                                                          \
+        a, b, c, d, a, b, c, d                                                 \
+    }
+#define INDEXES4(a, b, c, d) a, b, c, d, (a) + 4, (b) + 4, (c) + 4, (d) + 4
+#else
+#define LANES4(a, b, c, d)                                                     \
+    {                                                                          \
+        a, b, c, d                                                             \
+    }
+#define INDEXES4(a, b, c, d) a, b, c, d
+#endif
+
+#if defined(__clang__)
+#define shuffle4(x, a, b, c, d)                                                \
+    (__builtin_shufflevector(x, x, INDEXES4(a, b, c, d)))
+#else
+#define shuffle4(x, a, b, c, d)                                                \
+    (__builtin_shuffle(x, (lanes){INDEXES4(a, b, c, d)}))
+#endif
+
+#define ALL (~(uint64_t)0)
+
+/*
+ * Run the ladder of x25519_q with lanes 0 to 3 holding (x2, z2, x3, z3), so
+ * that each step takes three vector multiplications, as in sandy2x:
+ *
+ * (D, C, A, B) * (A, B, A, B) = (DA, CB, AA, BB)
+ * (DA + CB, DA - CB, AA, E) * (DA + CB, DA - CB, BB, AA + E(a - 2)/4)
+ * (x3, (DA - CB)^2, x2, z2) * (1, x1, 1, 1)
+ *
+ * x1 is public, so when it fits in a word, the last one is a multiplication by
+ * a word instead.
+ */
+static void ladder1(fe x2, fe z2, const unsigned char k[X25519_LEN],
+                    const fe x1)
+{
+    const lanes odd = LANES4(0, ALL, 0, ALL), low = LANES4(ALL, ALL, 0, 0),
+                lane2 = LANES4(0, 0, ALL, 0), lane3 = LANES4(0, 0, 0, ALL);
+    unsigned char u[X25519_LEN], one[X25519_LEN] = {1}, zero[X25519_LEN] = {0};
+    const unsigned char *init[4], *mul_x1[4];
+    fev v, x, s, t, m, q;
+    lanes swap = {0}, a24 = {0}, w;
+    unsigned hi = 0;
+    fe tmp;
+    int i, j, lane;
+
+    (void)memcpy(tmp, x1, sizeof(fe));
+    (void)canon(tmp);
+    fe_write(u, tmp);
+    init[0] = one;
+    init[1] = zero;
+    init[2] = u;
+    init[3] = one;
+    mul_x1[0] = one;
+    mul_x1[1] = one;
+    mul_x1[2] = one;
+    mul_x1[3] = u;
+    for (lane = 0; lane < LITH_X25519_LANES; ++lane)
+    {
+        fev_set_lane(v, lane, init[lane % 4]);
+        fev_set_lane(x, lane, mul_x1[lane % 4]);
+    }
+    for (i = 3; i < X25519_LEN; ++i)
+    {
+        hi |= u[i];
+    }
+    w = x[0];
+    a24 += 121665;
+
+    for (i = X25519_BITS - 1; i >= 0; --i)
+    {
+        lanes kb = {0}, sw;
+        kb += (uint64_t)0 - ((k[i / 8] >> (i % 8)) & 1U);
+        sw = swap ^ kb;
+        swap = kb;
+        for (j = 0; j < VLIMBS; ++j)
+        {
+            v[j] ^= (v[j] ^ shuffle4(v[j], 2, 3, 0, 1)) & sw;
+            s[j] = shuffle4(v[j], 1, 0, 3, 2);
+        }
+        fev_addsub(t, s, v, odd); /* (A, B, C, D) */
+        for (j = 0; j < VLIMBS; ++j)
+        {
+            s[j] = shuffle4(t[j], 3, 2, 0, 1); /* (D, C, A, B) */
+            t[j] = shuffle4(t[j], 0, 1, 0, 1); /* (A, B, A, B) */
+        }
+        fev_mul(m, s, t); /* (DA, CB, AA, BB) */
+        for (j = 0; j < VLIMBS; ++j)
+        {
+            s[j] = shuffle4(m[j], 1, 0, 3, 2); /* (CB, DA, BB, AA) */
+        }
+        fev_addsub(t, s, m, odd); /* (DA + CB, DA - CB, AA + BB, E) */
+        fev_mul_word(q, t, a24);
+        fev_add(q, q, s); /* lane 3: AA + E(a - 2)/4 */
+        for (j = 0; j < VLIMBS; ++j)
+        {
+            m[j] = (t[j] & ~lane2) | (m[j] & lane2);
+            t[j] = (t[j] & low) | (s[j] & lane2) | (q[j] & lane3);
+        }
+        fev_mul(m, m, t); /* (x3, (DA - CB)^2, x2, z2) */
+        for (j = 0; j < VLIMBS; ++j)
+        {
+            v[j] = shuffle4(m[j], 2, 3, 0, 1);
+        }
+        if (hi == 0)
+        {
+            fev_mul_word(v, v, w);
+        }
+        else
+        {
+            fev_mul(v, v, x);
+        }
+#if (LITH_ENABLE_WATCHDOG)
+        lith_watchdog_pet();
+#endif
+    }
+
+    for (j = 0; j < VLIMBS; ++j)
+    {
+        v[j] ^= (v[j] ^ shuffle4(v[j], 2, 3, 0, 1)) & swap;
+    }
+    fev_get_lane(u, v, 0);
+    fe_read(x2, u);
+    fev_get_lane(u, v, 1);
+    fe_read(z2, u);
+}
+
+#endif /* LITH_X25519_LANES > 1 */
+
+bool ladder_lanes(fe x2, fe z2, const unsigned char k[X25519_LEN],
+                  const fe x1)
+{
+#if (LITH_X25519_LANES > 1)
+    ladder1(x2, z2, k, x1);
+    return true;
+#else
+    (void)x2;
+    (void)z2;
+    (void)k;
+    (void)x1;
+    return false;
+#endif
+}
+
+/* The number of results converted to bytes with one field inversion. */
+#define CHUNK 32
+
+void x25519_batch(unsigned char *const out[],
+                  const unsigned char *const scalar[],
+                  const unsigned char *const point[], size_t n)
+{
+#if (LITH_X25519_LANES > 1)
+    unsigned char k[LITH_X25519_LANES][X25519_LEN], buf[X25519_LEN];
+    fev x1, x2, z2;
+    fe x[CHUNK], z[CHUNK], zinv[CHUNK];
+    size_t i, j, done = 0;
+    int lane;
+
+    for (i = 0; i < n; i += LITH_X25519_LANES)
+    {
+        for (lane = 0; lane < LITH_X25519_LANES; ++lane)
+        {
+            /* Lanes past the end repeat the last element. */
+            const size_t e = i + (size_t)lane < n ? i + (size_t)lane : n - 1;
+            clamp(k[lane], scalar[e]);
+            fev_set_lane(x1, lane, point[e]);
+        }
+        ladder(x2, z2, k, x1);
+        for (lane = 0; lane < LITH_X25519_LANES && i + (size_t)lane < n;
+             ++lane)
+        {
+            j = i + (size_t)lane - done;
+            fev_get_lane(buf, x2, lane);
+            fe_read(x[j], buf);
+            fev_get_lane(buf, z2, lane);
+            fe_read(z[j], buf);
+        }
+
+        /* Convert to bytes when the chunk is full, or at the end. */
+        j = i + (size_t)lane - done;
+        if (j + LITH_X25519_LANES > CHUNK || i + (size_t)lane == n)
+        {
+            fe_batch_inv(zinv, (const fe *)z, j);
+            for (lane = 0; (size_t)lane < j; ++lane)
+            {
+                mul1(x[lane], zinv[lane]);
+                (void)canon(x[lane]);
+                fe_write(out[done + (size_t)lane], x[lane]);
+            }
+            done += j;
+        }
+    }
+#else
+    size_t i;
+    for (i = 0; i < n; ++i)
+    {
+        x25519(out[i], scalar[i], point[i]);
+    }
+#endif
+}
@@ -0,0 +1,133 @@
+/*
+ * Part of liblithium, under the Apache License v2.0.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <lithium/gimli_aead.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_LEN 32
+#define TAG_LEN GIMLI_AEAD_TAG_DEFAULT_LEN
+#define NUM_PACKETS ((MAX_LEN + 1) * (MAX_LEN + 1))
+
+static unsigned char msg[MAX_LEN], ad[MAX_LEN];
+static unsigned char key[GIMLI_AEAD_KEY_LEN], nonce[GIMLI_AEAD_NONCE_LEN];
+static unsigned char ct[NUM_PACKETS][MAX_LEN + TAG_LEN];
+static unsigned char pt[NUM_PACKETS][MAX_LEN];
+static unsigned char exp[MAX_LEN + TAG_LEN];
+
+static unsigned char *c[NUM_PACKETS], *t[NUM_PACKETS], *p[NUM_PACKETS];
+static const unsigned char *m[NUM_PACKETS], *a[NUM_PACKETS], *n[NUM_PACKETS],
+    *k[NUM_PACKETS];
+static size_t mlen[NUM_PACKETS], adlen[NUM_PACKETS];
+static bool ok[NUM_PACKETS];
+
+static void init_buffer(unsigned char *buf, size_t len)
+{
+    for (size_t i = 0; i < len; i++)
+    {
+        buf[i] = (unsigned char)i;
+    }
+}
+
+static int fail(const char *what)
+{
+    printf("FAIL %s\n", what);
+    return EXIT_FAILURE;
+}
+
+static bool decrypt_many(void)
+{
+    return gimli_aead_decrypt_many(p, ok, (const unsigned char *const *)c,
+                                   mlen, (const unsigned char *const *)t,
+                                   TAG_LEN, a, adlen, n, k, NUM_PACKETS);
+}
+
+static void corrupt_every_third_tag(void)
+{
+    for (size_t i = 0; i < NUM_PACKETS; i += 3)
+    {
+        t[i][TAG_LEN - 1] ^= 0xFFU;
+    }
+}
+
+int main(void)
+{
+    size_t i = 0;
+
+    init_buffer(key, sizeof key);
+    init_buffer(nonce, sizeof nonce);
+    init_buffer(msg, sizeof msg);
+    init_buffer(ad, sizeof ad);
+
+    /* Every message and associated data length up to MAX_LEN, in one batch. */
+    for (size_t ml = 0; ml <= MAX_LEN; ml++)
+    {
+        for (size_t al = 0; al <= MAX_LEN; al++, i++)
+        {
+            c[i] = ct[i];
+            t[i] = &ct[i][ml];
+            p[i] = pt[i];
+            m[i] = msg;
+            a[i] = ad;
+            n[i] = nonce;
+            k[i] = key;
+            mlen[i] = ml;
+            adlen[i] = al;
+        }
+    }
+
+    gimli_aead_encrypt_many(c, t, TAG_LEN, m, mlen, a, adlen, n, k,
+                            NUM_PACKETS);
+    for (i = 0; i < NUM_PACKETS; i++)
+    {
+        gimli_aead_encrypt(exp, &exp[mlen[i]], TAG_LEN, msg, mlen[i], ad,
+                           adlen[i], nonce, key);
+        if (memcmp(ct[i], exp, mlen[i] + TAG_LEN) != 0)
+        {
+            return fail("encrypt_many does not match encrypt");
+        }
+    }
+
+    if (!decrypt_many())
+    {
+        return fail("decrypt_many on valid inputs");
+    }
+    for (i = 0; i < NUM_PACKETS; i++)
+    {
+        if (!ok[i] || memcmp(pt[i], msg, mlen[i]) != 0)
+        {
+            return fail("decrypt_many plaintext");
+        }
+    }
+
+    /* Only the packets with a corrupted tag fail, and their output is zero. */
+    corrupt_every_third_tag();
+    if (decrypt_many())
+    {
+        return fail("decrypt_many on invalid inputs");
+    }
+    for (i = 0; i < NUM_PACKETS; i++)
+    {
+        const bool bad = i % 3 == 0;
+        if (ok[i] == bad)
+        {
+            return fail("decrypt_many result for a packet");
+        }
+        for (size_t j = 0; bad && j < mlen[i]; j++)
+        {
+            if (pt[i][j] != 0)
+            {
+                return fail("decrypt_many output on authentication failure");
+            }
+        }
+    }
+    corrupt_every_third_tag();
+    if (!decrypt_many())
+    {
+        return fail("decrypt_many after restoring the tags");
+    }
+}
@@ -0,0 +1,186 @@
+/*
+ * Part of liblithium, under the Apache License v2.0.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <lithium/gimli_aead.h>
+#include <lithium/gimli_aead_stream.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CHUNK_LEN 100
+#define MAX_LEN 2000
+#define TAG_LEN GIMLI_AEAD_TAG_DEFAULT_LEN
+#define MAX_CLEN (MAX_LEN + (MAX_LEN / CHUNK_LEN + 1) * TAG_LEN)
+
+static const size_t lens[] = {
+    0, 1, CHUNK_LEN - 1, CHUNK_LEN, CHUNK_LEN + 1, 3 * CHUNK_LEN, 1234, MAX_LEN,
+};
+
+static unsigned char msg[MAX_LEN], ct[MAX_CLEN], pt[MAX_LEN];
+static unsigned char exp[CHUNK_LEN + TAG_LEN];
+static unsigned char key[GIMLI_AEAD_KEY_LEN];
+static unsigned char prefix[GIMLI_AEAD_STREAM_PREFIX_LEN];
+
+static int fail(const char *what, size_t len)
+{
+    printf("FAIL %s, length %zu\n", what, len);
+    return EXIT_FAILURE;
+}
+
+static int test_len(size_t len)
+{
+    const size_t clen = gimli_aead_stream_len(len, CHUNK_LEN);
+    const size_t nchunks = (clen - len) / TAG_LEN;
+    const size_t stride = CHUNK_LEN + TAG_LEN;
+    unsigned char n[GIMLI_AEAD_NONCE_LEN];
+
+    if (!gimli_aead_stream_encrypt(ct, msg, len, CHUNK_LEN, 0, true, prefix,
+                                   key))
+    {
+        return fail("encrypt", len);
+    }
+
+    /* Each chunk is gimli_aead_encrypt under its derived nonce. */
+    for (size_t i = 0; i < nchunks; ++i)
+    {
+        const size_t off = i * CHUNK_LEN;
+        const size_t mlen = len - off < CHUNK_LEN ? len - off : CHUNK_LEN;
+        gimli_aead_stream_nonce(n, prefix, (uint32_t)i, i == nchunks - 1);
+        gimli_aead_encrypt(exp, &exp[mlen], TAG_LEN, &msg[off], mlen, NULL, 0,
+                           n, key);
+        if (memcmp(&ct[i * stride], exp, mlen + TAG_LEN) != 0)
+        {
+            return fail("chunk ciphertext", len);
+        }
+
+        /* Random access to a single chunk. */
+        memset(pt, 0xAA, sizeof pt);
+        if (!gimli_aead_stream_decrypt(pt, &ct[i * stride], mlen + TAG_LEN,
+                                       CHUNK_LEN, (uint32_t)i,
+                                       i == nchunks - 1, prefix, key) ||
+            memcmp(pt, &msg[off], mlen) != 0)
+        {
+            return fail("single chunk decrypt", len);
+        }
+        /* The wrong index or last flag does not authenticate. */
+        if (gimli_aead_stream_decrypt(pt, &ct[i * stride], mlen + TAG_LEN,
+                                      CHUNK_LEN, (uint32_t)i + 1,
+                                      i == nchunks - 1, prefix, key) ||
+            (mlen == CHUNK_LEN &&
+             gimli_aead_stream_decrypt(pt, &ct[i * stride], mlen + TAG_LEN,
+                                       CHUNK_LEN, (uint32_t)i,
+                                       i != nchunks - 1, prefix, key)))
+        {
+            return fail("misplaced chunk decrypt", len);
+        }
+    }
+
+    if (!gimli_aead_stream_decrypt(pt, ct, clen, CHUNK_LEN, 0, true, prefix,
+                                   key) ||
+        memcmp(pt, msg, len) != 0)
+    {
+        return fail("decrypt", len);
+    }
+
+    /* Split the stream into two ranges, as two threads would. */
+    if (nchunks > 1)
+    {
+        const size_t split = nchunks / 2;
+        static unsigned char ct2[MAX_CLEN];
+        if (!gimli_aead_stream_encrypt(ct2, msg, split * CHUNK_LEN, CHUNK_LEN,
+                                       0, false, prefix, key) ||
+            !gimli_aead_stream_encrypt(&ct2[split * stride],
+                                       &msg[split * CHUNK_LEN],
+                                       len - split * CHUNK_LEN, CHUNK_LEN,
+                                       (uint32_t)split, true, prefix, key) ||
+            memcmp(ct, ct2, clen) != 0)
+        {
+            return fail("split encrypt", len);
+        }
+        memset(pt, 0, sizeof pt);
+        if (!gimli_aead_stream_decrypt(&pt[split * CHUNK_LEN],
+                                       &ct[split * stride],
+                                       clen - split * stride, CHUNK_LEN,
+                                       (uint32_t)split, true, prefix, key) ||
+            !gimli_aead_stream_decrypt(pt, ct, split * stride, CHUNK_LEN, 0,
+                                       false, prefix, key) ||
+            memcmp(pt, msg, len) != 0)
+        {
+            return fail("split decrypt", len);
+        }
+
+        /* A stream truncated at a chunk boundary does not authenticate. */
+        if (gimli_aead_stream_decrypt(pt, ct, split * stride, CHUNK_LEN, 0,
+                                      true, prefix, key))
+        {
+            return fail("truncated decrypt", len);
+        }
+    }
+
+    /* A modified chunk fails the whole range, and the plaintext is zeroed. */
+    ct[clen - 1] ^= 0x01;
+    if (gimli_aead_stream_decrypt(pt, ct, clen, CHUNK_LEN, 0, true, prefix,
+                                  key))
+    {
+        return fail("modified decrypt", len);
+    }
+    for (size_t i = 0; i < len; ++i)
+    {
+        if (pt[i] != 0)
+        {
+            return fail("plaintext not cleared", len);
+        }
+    }
+    ct[clen - 1] ^= 0x01;
+
+    /* A stream missing its last byte is rejected. */
+    if (gimli_aead_stream_decrypt(pt, ct, clen - 1, CHUNK_LEN, 0, true, prefix,
+                                  key))
+    {
+        return fail("malformed decrypt", len);
+    }
+    return EXIT_SUCCESS;
+}
+
+int main(void)
+{
+    for (size_t i = 0; i < sizeof msg; ++i)
+    {
+        msg[i] = (unsigned char)(i * 7);
+    }
+    for (size_t i = 0; i < sizeof key; ++i)
+    {
+        key[i] = (unsigned char)(0x40 + i);
+    }
+    for (size_t i = 0; i < sizeof prefix; ++i)
+    {
+        prefix[i] = (unsigned char)(0x80 + i);
+    }
+
+    for (size_t i = 0; i < sizeof lens / sizeof lens[0]; ++i)
+    {
+        if (test_len(lens[i]) != EXIT_SUCCESS)
+        {
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (gimli_aead_stream_encrypt(ct, msg, CHUNK_LEN + 1, CHUNK_LEN, 0, false,
+                                  prefix, key))
+    {
+        printf("FAIL encrypt of a partial chunk that is not last\n");
+        return EXIT_FAILURE;
+    }
+    if (!gimli_aead_stream_encrypt(ct, msg, 2 * CHUNK_LEN, CHUNK_LEN,
+                                   UINT32_MAX - 1, true, prefix, key) ||
+        gimli_aead_stream_encrypt(ct, msg, 3 * CHUNK_LEN, CHUNK_LEN,
+                                  UINT32_MAX - 1, true, prefix, key))
+    {
+        printf("FAIL chunk index limit\n");
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
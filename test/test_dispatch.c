@@ -0,0 +1,135 @@
+/*
+ * Part of liblithium, under the Apache License v2.0.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <lithium/dispatch.h>
+#include <lithium/gimli.h>
+#include <lithium/gimli_aead.h>
+#include <lithium/gimli_hash.h>
+#include <lithium/x25519.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * Run the dispatched kernels at every level supported by this CPU and check
+ * that they all agree with each other and with known answers.
+ */
+
+static const uint32_t gimli_exp[GIMLI_WORDS] = {
+    0xba11c85a, 0x91bad119, 0x380ce880, 0xd24c2c68,
+    0x3eceffea, 0x277a921c, 0x4f73a0bd, 0xda5a9cd8,
+    0x84b673f0, 0x34e52ff7, 0x9e2bef49, 0xf41bb8d6,
+};
+
+/* RFC7748 section 5.2 */
+static const unsigned char x25519_scalar[X25519_LEN] = {
+    0xA5, 0x46, 0xE3, 0x6B, 0xF0, 0x52, 0x7C, 0x9D, 0x3B, 0x16, 0x15,
+    0x4B, 0x82, 0x46, 0x5E, 0xDD, 0x62, 0x14, 0x4C, 0x0A, 0xC1, 0xFC,
+    0x5A, 0x18, 0x50, 0x6A, 0x22, 0x44, 0xBA, 0x44, 0x9A, 0xC4,
+};
+
+static const unsigned char x25519_point[X25519_LEN] = {
+    0xE6, 0xDB, 0x68, 0x67, 0x58, 0x30, 0x30, 0xDB, 0x35, 0x94, 0xC1,
+    0xA4, 0x24, 0xB1, 0x5F, 0x7C, 0x72, 0x66, 0x24, 0xEC, 0x26, 0xB3,
+    0x35, 0x3B, 0x10, 0xA9, 0x03, 0xA6, 0xD0, 0xAB, 0x1C, 0x4C,
+};
+
+static const unsigned char x25519_exp[X25519_LEN] = {
+    0xC3, 0xDA, 0x55, 0x37, 0x9D, 0xE9, 0xC6, 0x90, 0x8E, 0x94, 0xEA,
+    0x4D, 0xF2, 0x8D, 0x08, 0x4F, 0x32, 0xEC, 0xCF, 0x03, 0x49, 0x1C,
+    0x71, 0xF7, 0x54, 0xB4, 0x07, 0x55, 0x77, 0xA2, 0x85, 0x52,
+};
+
+#define MSG_LEN 1000
+
+struct results
+{
+    unsigned char hash[GIMLI_HASH_DEFAULT_LEN];
+    unsigned char c[MSG_LEN];
+    unsigned char t[GIMLI_AEAD_TAG_DEFAULT_LEN];
+    uint32_t x8[8][GIMLI_WORDS];
+};
+
+static int run(struct results *r)
+{
+    static unsigned char m[MSG_LEN], d[MSG_LEN];
+    static const unsigned char n[GIMLI_AEAD_NONCE_LEN] = {1},
+                               k[GIMLI_AEAD_KEY_LEN] = {2};
+    uint32_t x[GIMLI_WORDS];
+    unsigned char out[X25519_LEN];
+    unsigned i, lane;
+
+    for (i = 0; i < GIMLI_WORDS; ++i)
+        x[i] = i * i * i + i * 0x9E3779B9;
+    gimli(x);
+    if (memcmp(x, gimli_exp, sizeof x) != 0)
+    {
+        printf("gimli mismatch\n");
+        return 0;
+    }
+
+    for (lane = 0; lane < 8; ++lane)
+    {
+        for (i = 0; i < GIMLI_WORDS; ++i)
+            r->x8[lane][i] = i * lane + 0x9E3779B9;
+    }
+    gimli_x8(r->x8);
+    gimli_x4(r->x8);
+
+    for (i = 0; i < MSG_LEN; ++i)
+        m[i] = (unsigned char)i;
+    gimli_hash(r->hash, sizeof r->hash, m, MSG_LEN);
+    gimli_aead_encrypt(r->c, r->t, sizeof r->t, m, MSG_LEN, m, 33, n, k);
+    if (!gimli_aead_decrypt(d, r->c, MSG_LEN, r->t, sizeof r->t, m, 33, n, k) ||
+        memcmp(d, m, MSG_LEN) != 0)
+    {
+        printf("gimli_aead_decrypt failed\n");
+        return 0;
+    }
+
+    x25519(out, x25519_scalar, x25519_point);
+    if (memcmp(out, x25519_exp, X25519_LEN) != 0)
+    {
+        printf("x25519 mismatch\n");
+        return 0;
+    }
+    return 1;
+}
+
+int main(void)
+{
+    static struct results ref, r;
+    const int best = lith_dispatch_level();
+
+    for (int level = LITH_LEVEL_SCALAR; level <= best; ++level)
+    {
+        if (lith_dispatch_force(level) != level)
+        {
+            printf("FAIL could not force level %d\n", level);
+            return EXIT_FAILURE;
+        }
+        if (!run(&r))
+        {
+            printf("FAIL level %d\n", level);
+            return EXIT_FAILURE;
+        }
+        if (level == LITH_LEVEL_SCALAR)
+        {
+            ref = r;
+        }
+        else if (memcmp(&r, &ref, sizeof r) != 0)
+        {
+            printf("FAIL level %d does not match scalar\n", level);
+            return EXIT_FAILURE;
+        }
+    }
+    if (lith_dispatch_force(best + 1) != best)
+    {
+        printf("FAIL forced an unsupported level\n");
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -8,13 +8,116 @@
 #include <assert.h>
 #include <string.h>
 
+static void randomize(unsigned char x[X25519_LEN])
+{
+    static unsigned int seed = 0x87654321;
+    for (int i = 0; i < X25519_LEN; i++)
+    {
+        seed += seed * seed | 5;
+        x[i] = (unsigned char)(seed >> 24);
+    }
+}
+
+/* Check that x canonicalizes to the little-endian bytes exp. */
+static void check_canon(fe x, const unsigned char exp[X25519_LEN])
+{
+    unsigned char out[X25519_LEN];
+    canon(x);
+    fe_write(out, x);
+    assert(memcmp(out, exp, X25519_LEN) == 0);
+}
+
 int main(void)
 {
-    fe m, z, a;
-    memset(m, 0xFF, sizeof m);
+    unsigned char bytes[X25519_LEN], zero[X25519_LEN] = {0},
+                                     one[X25519_LEN] = {1};
+    fe m, z, a, b, c;
+
+    /* 0 - (2^256 - 1) + (2^256 - 1) = 0 */
+    memset(bytes, 0xFF, sizeof bytes);
+    fe_read(m, bytes);
     memset(z, 0, sizeof z);
     sub(a, z, m);
     add(a, a, m);
-    canon(a);
-    assert(memcmp(a, z, sizeof a) == 0);
+    assert(canon(a) != 0);
+    check_canon(a, zero);
+
+    /* p and p + 1 canonicalize to 0 and 1. */
+    memset(bytes, 0xFF, sizeof bytes);
+    bytes[0] = 0xED;
+    bytes[X25519_LEN - 1] = 0x7F;
+    fe_read(a, bytes);
+    assert(canon(a) != 0);
+    fe_read(a, bytes);
+    check_canon(a, zero);
+    bytes[0] = 0xEE;
+    fe_read(a, bytes);
+    assert(canon(a) == 0);
+    fe_read(a, bytes);
+    check_canon(a, one);
+
+    /* 2^255 - 1 = p + 18 canonicalizes to 18. */
+    bytes[0] = 0xFF;
+    fe_read(a, bytes);
+    memset(bytes, 0, sizeof bytes);
+    bytes[0] = 18;
+    check_canon(a, bytes);
+
+    /* Batch inversion agrees with inv, and a zero only zeroes its output. */
+    {
+        fe in[5], out[5];
+        for (int i = 0; i < 5; ++i)
+        {
+            randomize(bytes);
+            fe_read(in[i], bytes);
+        }
+        memset(in[2], 0, sizeof in[2]);
+        fe_batch_inv(out, in, 5);
+        for (int i = 0; i < 5; ++i)
+        {
+            unsigned char x[X25519_LEN], y[X25519_LEN];
+            memcpy(a, in[i], sizeof a);
+            inv(a);
+            canon(a);
+            canon(out[i]);
+            fe_write(x, a);
+            fe_write(y, out[i]);
+            assert(memcmp(x, y, sizeof x) == 0);
+        }
+        check_canon(out[2], zero);
+    }
+
+    for (int i = 0; i < 100; ++i)
+    {
+        unsigned char x[X25519_LEN], y[X25519_LEN];
+        randomize(bytes);
+        fe_read(a, bytes);
+        memcpy(b, a, sizeof b);
+        memcpy(c, a, sizeof c);
+
+        /* Squaring agrees with multiplication. */
+        sqr1(b);
+        mul1(c, a);
+        canon(b);
+        canon(c);
+        fe_write(x, b);
+        fe_write(y, c);
+        assert(memcmp(x, y, sizeof x) == 0);
+
+        /* a * a^-1 = 1 */
+        memcpy(b, a, sizeof b);
+        inv(b);
+        mul1(b, a);
+        check_canon(b, one);
+
+        /* (a + a) - a = a * 1 */
+        add(b, a, a);
+        sub(b, b, a);
+        mul_word(c, a, 1);
+        canon(b);
+        canon(c);
+        fe_write(x, b);
+        fe_write(y, c);
+        assert(memcmp(x, y, sizeof x) == 0);
+    }
 }
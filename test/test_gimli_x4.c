@@ -0,0 +1,48 @@
+/*
+ * Part of liblithium, under the Apache License v2.0.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <lithium/gimli.h>
+
+#include <stdio.h>
+#include <string.h>
+
+/*
+ * Permute distinct states in every lane of gimli_x4 and gimli_x8, check each
+ * lane against gimli, and print the lane holding the test_gimli input so the
+ * output can be compared with test_gimli.exp.
+ */
+int main(void)
+{
+    uint32_t x4[4][GIMLI_WORDS], x8[8][GIMLI_WORDS], ref[8][GIMLI_WORDS];
+    unsigned int i, lane;
+
+    for (lane = 0; lane < 8; ++lane)
+    {
+        for (i = 0; i < GIMLI_WORDS; ++i)
+            ref[lane][i] = i * i * i + i * 0x9E3779B9 + lane * 0x01010101;
+    }
+    memcpy(x4, ref, sizeof x4);
+    memcpy(x8, ref, sizeof x8);
+
+    gimli_x4(x4);
+    gimli_x8(x8);
+
+    for (lane = 0; lane < 8; ++lane)
+    {
+        gimli(ref[lane]);
+        if (memcmp(x8[lane], ref[lane], sizeof ref[lane]) != 0)
+            printf("gimli_x8 lane %u mismatch\n", lane);
+        if (lane < 4 && memcmp(x4[lane], ref[lane], sizeof ref[lane]) != 0)
+            printf("gimli_x4 lane %u mismatch\n", lane);
+    }
+
+    for (i = 0; i < GIMLI_WORDS; ++i)
+    {
+        printf("%08x ", x4[0][i]);
+        if (i % 4 == 3)
+            printf("\n");
+    }
+    return 0;
+}
@@ -0,0 +1,60 @@
+/*
+ * Part of liblithium, under the Apache License v2.0.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <lithium/gimli_hash.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define N 100
+#define MAX_MSG_LEN 4096
+#define MAX_HASH_LEN 80
+
+static unsigned char msgs[N][MAX_MSG_LEN];
+static unsigned char hashes[N][MAX_HASH_LEN];
+
+int main(void)
+{
+    static const size_t hlens[] = {1, 16, 17, GIMLI_HASH_DEFAULT_LEN, 64, 80};
+    const unsigned char *m[N];
+    unsigned char *h[N];
+    size_t mlen[N];
+    unsigned char exp[MAX_HASH_LEN];
+    unsigned x = 1;
+
+    for (size_t i = 0; i < N; ++i)
+    {
+        /* A mix of lengths around block boundaries and longer messages. */
+        x = x * 1103515245 + 12345;
+        mlen[i] = i < 40 ? i : (x >> 8) % (MAX_MSG_LEN + 1);
+        for (size_t j = 0; j < mlen[i]; ++j)
+        {
+            msgs[i][j] = (unsigned char)(i + j * 7);
+        }
+        m[i] = msgs[i];
+        h[i] = hashes[i];
+    }
+
+    for (size_t k = 0; k < sizeof hlens / sizeof hlens[0]; ++k)
+    {
+        for (size_t n = 0; n <= N; n += n < 10 ? 1 : 45)
+        {
+            memset(hashes, 0, sizeof hashes);
+            gimli_hash_many(h, hlens[k], m, mlen, n);
+            for (size_t i = 0; i < n; ++i)
+            {
+                gimli_hash(exp, hlens[k], m[i], mlen[i]);
+                if (memcmp(hashes[i], exp, hlens[k]) != 0)
+                {
+                    printf("FAIL message %zu of %zu, mlen %zu, hlen %zu\n", i,
+                           n, mlen[i], hlens[k]);
+                    return EXIT_FAILURE;
+                }
+            }
+        }
+    }
+    return EXIT_SUCCESS;
+}
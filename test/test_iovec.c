@@ -0,0 +1,125 @@
+/*
+ * Part of liblithium, under the Apache License v2.0.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <lithium/gimli_aead.h>
+#include <lithium/gimli_hash.h>
+#include <lithium/sign.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define LEN 700
+#define MAX_FRAGS LEN
+
+static unsigned char msg[LEN], buf[LEN];
+static struct lith_iovec iov[MAX_FRAGS];
+static unsigned char *out[MAX_FRAGS];
+
+/* Split buf into fragments, with sizes taken cyclically from sizes. */
+static size_t split(const size_t *sizes, size_t nsizes)
+{
+    size_t n = 0, off = 0;
+    while (off < LEN)
+    {
+        size_t len = sizes[n % nsizes];
+        if (len > LEN - off)
+        {
+            len = LEN - off;
+        }
+        iov[n].base = &buf[off];
+        iov[n].len = len;
+        out[n] = &buf[off];
+        off += len;
+        ++n;
+    }
+    return n;
+}
+
+int main(void)
+{
+    static const size_t sizes[][4] = {
+        {1, 1, 1, 1},    {3, 0, 5, 2},   {15, 17, 16, 1},
+        {100, 7, 0, 33}, {LEN, 0, 0, 0}, {31, 47, 13, 64},
+    };
+    static const unsigned char n[GIMLI_AEAD_NONCE_LEN] = {1},
+                               k[GIMLI_AEAD_KEY_LEN] = {2};
+    unsigned char h[GIMLI_HASH_DEFAULT_LEN], hv[GIMLI_HASH_DEFAULT_LEN];
+    unsigned char prehash[LITH_SIGN_PREHASH_LEN],
+        prehashv[LITH_SIGN_PREHASH_LEN];
+    unsigned char c[LEN], t[GIMLI_AEAD_TAG_DEFAULT_LEN],
+        tv[GIMLI_AEAD_TAG_DEFAULT_LEN];
+    gimli_state g;
+
+    for (size_t i = 0; i < LEN; ++i)
+    {
+        msg[i] = (unsigned char)(i * 13 + 5);
+    }
+    gimli_hash(h, sizeof h, msg, LEN);
+    lith_sign_init(&g);
+    lith_sign_update(&g, msg, LEN);
+    lith_sign_final_prehash(&g, prehash);
+    gimli_aead_encrypt(c, t, sizeof t, msg, LEN, NULL, 0, n, k);
+
+    for (size_t s = 0; s < sizeof sizes / sizeof sizes[0]; ++s)
+    {
+        /* Start each update at a different offset within a block. */
+        for (size_t pre = 0; pre < 20; pre += 7)
+        {
+            const size_t nfrags = split(sizes[s], 4);
+            memcpy(buf, msg, LEN);
+
+            gimli_hash_init(&g);
+            gimli_hash_update(&g, msg, pre);
+            gimli_hash_updatev(&g, iov, nfrags);
+            gimli_hash_update(&g, &msg[pre], LEN - pre);
+            gimli_hash_final(&g, hv, sizeof hv);
+            gimli_hash_init(&g);
+            gimli_hash_update(&g, msg, pre);
+            gimli_hash_update(&g, msg, LEN);
+            gimli_hash_update(&g, &msg[pre], LEN - pre);
+            gimli_hash_final(&g, h, sizeof h);
+            if (memcmp(h, hv, sizeof h) != 0)
+            {
+                printf("FAIL gimli_hash_updatev sizes %zu offset %zu\n", s,
+                       pre);
+                return EXIT_FAILURE;
+            }
+        }
+
+        const size_t nfrags = split(sizes[s], 4);
+        memcpy(buf, msg, LEN);
+
+        lith_sign_init(&g);
+        lith_sign_updatev(&g, iov, nfrags);
+        lith_sign_final_prehash(&g, prehashv);
+        if (memcmp(prehash, prehashv, sizeof prehash) != 0)
+        {
+            printf("FAIL lith_sign_updatev sizes %zu\n", s);
+            return EXIT_FAILURE;
+        }
+
+        /* In-place encryption and decryption. */
+        gimli_aead_init(&g, n, k);
+        gimli_aead_final_ad(&g);
+        gimli_aead_encrypt_updatev(&g, out, iov, nfrags);
+        gimli_aead_encrypt_final(&g, tv, sizeof tv);
+        if (memcmp(buf, c, LEN) != 0 || memcmp(t, tv, sizeof t) != 0)
+        {
+            printf("FAIL gimli_aead_encrypt_updatev sizes %zu\n", s);
+            return EXIT_FAILURE;
+        }
+        gimli_aead_init(&g, n, k);
+        gimli_aead_final_ad(&g);
+        gimli_aead_decrypt_updatev(&g, out, iov, nfrags);
+        if (!gimli_aead_decrypt_final(&g, t, sizeof t) ||
+            memcmp(buf, msg, LEN) != 0)
+        {
+            printf("FAIL gimli_aead_decrypt_updatev sizes %zu\n", s);
+            return EXIT_FAILURE;
+        }
+    }
+    return EXIT_SUCCESS;
+}
@@ -38,6 +38,9 @@
 // data, nonce, or key is modified, and that the message output is zeroed out
 // in this case.
 
+// This file was modified on October 17, 2026 to test gimli_aead_verify and
+// gimli_aead_decrypt_verified alongside gimli_aead_decrypt.
+
 #include <stdio.h>
 #include <string.h>
 
@@ -51,6 +54,34 @@
 
 void init_buffer(unsigned char *buffer, size_t numbytes);
 
+static int test_verify_long(const unsigned char *key,
+                            const unsigned char *nonce)
+{
+    // Long enough to use several rounds of the bulk verify path.
+    static unsigned char m[1001], c[sizeof(m)], m2[sizeof(m)];
+    unsigned char tag[GIMLI_AEAD_TAG_DEFAULT_LEN];
+
+    init_buffer(m, sizeof(m));
+    for (size_t len = sizeof(m) - 3; len <= sizeof(m); len++)
+    {
+        gimli_aead_encrypt(c, tag, sizeof(tag), m, len, NULL, 0, nonce, key);
+        if (!gimli_aead_decrypt_verified(m2, c, len, tag, sizeof(tag), NULL, 0,
+                                         nonce, key) ||
+            memcmp(m, m2, len))
+        {
+            printf("gimli_aead_decrypt_verified failed on a long message\n");
+            return KAT_CRYPTO_FAILURE;
+        }
+        c[len / 2] ^= 0x01U;
+        if (gimli_aead_verify(c, len, tag, sizeof(tag), NULL, 0, nonce, key))
+        {
+            printf("gimli_aead_verify succeeded on a modified long message\n");
+            return KAT_CRYPTO_FAILURE;
+        }
+    }
+    return KAT_SUCCESS;
+}
+
 void print_bstr(const char *label, const unsigned char *data, size_t length);
 
 int generate_test_vectors(void);
@@ -83,6 +114,11 @@ int generate_test_vectors(void)
     init_buffer(msg, sizeof(msg));
     init_buffer(ad, sizeof(ad));
 
+    if ((func_ret = test_verify_long(key, nonce)) != KAT_SUCCESS)
+    {
+        return func_ret;
+    }
+
     for (size_t mlen = 0; mlen <= MAX_MESSAGE_LENGTH; mlen++)
     {
 
@@ -112,6 +148,20 @@ int generate_test_vectors(void)
                 return KAT_CRYPTO_FAILURE;
             }
 
+            memset(msg2, 0, sizeof(msg2));
+            if (!gimli_aead_verify(ct, mlen, &ct[mlen],
+                                   GIMLI_AEAD_TAG_DEFAULT_LEN, ad, adlen,
+                                   nonce, key) ||
+                !gimli_aead_decrypt_verified(msg2, ct, mlen, &ct[mlen],
+                                             GIMLI_AEAD_TAG_DEFAULT_LEN, ad,
+                                             adlen, nonce, key) ||
+                memcmp(msg, msg2, mlen))
+            {
+                printf("gimli_aead_decrypt_verified did not recover the "
+                       "plaintext\n");
+                return KAT_CRYPTO_FAILURE;
+            }
+
             unsigned char *const p[] = {
                 mlen > 0 ? ct : NULL,
                 &ct[mlen],
@@ -141,6 +191,27 @@ int generate_test_vectors(void)
                             return KAT_CRYPTO_FAILURE;
                         }
                     }
+                    memset(msg2, 0xAA, sizeof(msg2));
+                    if (gimli_aead_verify(ct, mlen, &ct[mlen],
+                                          GIMLI_AEAD_TAG_DEFAULT_LEN, ad,
+                                          adlen, nonce, key) ||
+                        gimli_aead_decrypt_verified(
+                            msg2, ct, mlen, &ct[mlen],
+                            GIMLI_AEAD_TAG_DEFAULT_LEN, ad, adlen, nonce, key))
+                    {
+                        printf("gimli_aead_verify succeeded on an invalid "
+                               "input\n");
+                        return KAT_CRYPTO_FAILURE;
+                    }
+                    for (size_t j = 0; j < sizeof(msg2); ++j)
+                    {
+                        if (msg2[j] != 0xAA)
+                        {
+                            printf("gimli_aead_decrypt_verified wrote to the "
+                                   "plaintext on authentication failure\n");
+                            return KAT_CRYPTO_FAILURE;
+                        }
+                    }
                     *p[i] ^= 0xffU;
                 }
             }
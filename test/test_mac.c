@@ -0,0 +1,78 @@
+/*
+ * Part of liblithium, under the Apache License v2.0.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <lithium/gimli_hash.h>
+#include <lithium/gimli_mac.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define N 20
+#define MAX_LEN 200
+
+int main(void)
+{
+    unsigned char key[GIMLI_MAC_KEY_LEN];
+    unsigned char msgs[N][MAX_LEN], tags[N][GIMLI_MAC_DEFAULT_LEN];
+    unsigned char t[GIMLI_MAC_DEFAULT_LEN], exp[GIMLI_MAC_DEFAULT_LEN];
+    const unsigned char *m[N];
+    unsigned char *tp[N];
+    size_t mlen[N];
+    gimli_mac_key k;
+    gimli_mac_state g;
+    gimli_hash_state h;
+
+    for (size_t i = 0; i < sizeof key; ++i)
+    {
+        key[i] = (unsigned char)(0xA0 + i);
+    }
+    gimli_mac_key_init(&k, key);
+
+    for (size_t i = 0; i < N; ++i)
+    {
+        mlen[i] = i * i % (MAX_LEN + 1);
+        for (size_t j = 0; j < mlen[i]; ++j)
+        {
+            msgs[i][j] = (unsigned char)(i * 3 + j);
+        }
+        m[i] = msgs[i];
+        tp[i] = tags[i];
+    }
+    gimli_mac_many(tp, sizeof tags[0], m, mlen, N, &k);
+
+    for (size_t i = 0; i < N; ++i)
+    {
+        /* The tag is Gimli-Hash(key || m). */
+        gimli_hash_init(&h);
+        gimli_hash_update(&h, key, sizeof key);
+        gimli_hash_update(&h, m[i], mlen[i]);
+        gimli_hash_final(&h, exp, sizeof exp);
+
+        gimli_mac(t, sizeof t, m[i], mlen[i], &k);
+        if (memcmp(t, exp, sizeof t) != 0)
+        {
+            printf("FAIL gimli_mac message %zu\n", i);
+            return EXIT_FAILURE;
+        }
+
+        gimli_mac_init(&g, &k);
+        gimli_mac_update(&g, m[i], mlen[i] / 2);
+        gimli_mac_update(&g, &m[i][mlen[i] / 2], mlen[i] - mlen[i] / 2);
+        gimli_mac_final(&g, t, sizeof t);
+        if (memcmp(t, exp, sizeof t) != 0)
+        {
+            printf("FAIL streaming gimli_mac message %zu\n", i);
+            return EXIT_FAILURE;
+        }
+
+        if (memcmp(tags[i], exp, sizeof exp) != 0)
+        {
+            printf("FAIL gimli_mac_many message %zu\n", i);
+            return EXIT_FAILURE;
+        }
+    }
+    return EXIT_SUCCESS;
+}
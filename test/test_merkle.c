@@ -0,0 +1,170 @@
+/*
+ * Part of liblithium, under the Apache License v2.0.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <lithium/gimli_hash.h>
+#include <lithium/merkle.h>
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CHUNK_LEN 100
+#define MAX_CHUNKS 37
+#define H LITH_MERKLE_HASH_LEN
+
+static unsigned char data[MAX_CHUNKS * CHUNK_LEN];
+static unsigned char nodes[2 * 64 * H], rebuilt[2 * 64 * H];
+static unsigned char proof[LITH_MERKLE_MAX_PROOF_LEN * H];
+
+static void hash2(unsigned char *h, const char *domain, const unsigned char *a,
+                  size_t alen, const unsigned char *b, size_t blen)
+{
+    gimli_hash_state g;
+    gimli_hash_init(&g);
+    gimli_hash_update(&g, (const unsigned char *)domain, 16);
+    gimli_hash_update(&g, a, alen);
+    gimli_hash_update(&g, b, blen);
+    gimli_hash_final(&g, h, H);
+}
+
+/* Recursive reference for the subtree over leaves [lo, lo + width). */
+static void reference(unsigned char *h, size_t lo, size_t width, size_t len,
+                      size_t n)
+{
+    unsigned char l[H], r[H];
+    if (width == 1)
+    {
+        const size_t clen =
+            len - lo * CHUNK_LEN < CHUNK_LEN ? len - lo * CHUNK_LEN : CHUNK_LEN;
+        hash2(h, "lith_merkle_leaf", &data[lo * CHUNK_LEN], clen, NULL, 0);
+        return;
+    }
+    reference(l, lo, width / 2, len, n);
+    if (lo + width / 2 >= n)
+    {
+        memcpy(h, l, H);
+        return;
+    }
+    reference(r, lo + width / 2, width / 2, len, n);
+    hash2(h, "lith_merkle_node", l, H, r, H);
+}
+
+int main(void)
+{
+    static const size_t counts[] = {1, 2, 3, 8, 13, MAX_CHUNKS};
+    lith_merkle_tree t, t2;
+    unsigned char root[H], exp[H], top[H];
+    unsigned char count[8] = {0};
+
+    for (size_t i = 0; i < sizeof data; ++i)
+    {
+        data[i] = (unsigned char)(i * 7 + (i >> 8));
+    }
+
+    for (size_t c = 0; c < sizeof counts / sizeof counts[0]; ++c)
+    {
+        const size_t n = counts[c];
+        const size_t len = n * CHUNK_LEN - (n > 2 ? 37 : 0);
+        size_t p = 1;
+        while (p < n)
+        {
+            p *= 2;
+        }
+        if (lith_merkle_nodes(n) * H > sizeof nodes)
+        {
+            printf("FAIL test storage too small\n");
+            return EXIT_FAILURE;
+        }
+
+        /* Hash the chunks as two ranges, as two threads might. */
+        lith_merkle_init(&t, nodes, n, CHUNK_LEN);
+        lith_merkle_hash_chunks(&t, n / 2, &data[n / 2 * CHUNK_LEN],
+                                len - n / 2 * CHUNK_LEN);
+        lith_merkle_hash_chunks(&t, 0, data, n / 2 * CHUNK_LEN);
+        lith_merkle_build(&t);
+        lith_merkle_root(&t, root);
+
+        reference(top, 0, p, len, n);
+        count[0] = (unsigned char)n;
+        hash2(exp, "lith_merkle_root", count, sizeof count, top, H);
+        if (memcmp(root, exp, H) != 0)
+        {
+            printf("FAIL root of %zu chunks\n", n);
+            return EXIT_FAILURE;
+        }
+
+        for (size_t i = 0; i < n; ++i)
+        {
+            const unsigned char *chunk = &data[i * CHUNK_LEN];
+            const size_t clen = i == n - 1 ? len - i * CHUNK_LEN : CHUNK_LEN;
+            const size_t plen = lith_merkle_proof(&t, i, proof);
+            if (!lith_merkle_verify(root, n, i, chunk, clen, proof, plen))
+            {
+                printf("FAIL proof of chunk %zu of %zu\n", i, n);
+                return EXIT_FAILURE;
+            }
+            if (lith_merkle_verify(root, n, i, chunk, clen - 1, proof, plen) ||
+                lith_merkle_verify(root, n + 1, i, chunk, clen, proof, plen) ||
+                (plen > 0 && lith_merkle_verify(root, n, i, chunk, clen, proof,
+                                                plen - 1)) ||
+                (n > 1 && lith_merkle_verify(root, n, i ^ 1, chunk, clen,
+                                             proof, plen)))
+            {
+                printf("FAIL bad proof of chunk %zu of %zu accepted\n", i, n);
+                return EXIT_FAILURE;
+            }
+        }
+
+        /* Patch one chunk and compare with rebuilding the whole tree. */
+        const size_t i = n / 3;
+        data[i * CHUNK_LEN + 5] ^= 0x80;
+        lith_merkle_update(&t, i, &data[i * CHUNK_LEN],
+                           i == n - 1 ? len - i * CHUNK_LEN : CHUNK_LEN);
+        lith_merkle_root(&t, root);
+        lith_merkle_init(&t2, rebuilt, n, CHUNK_LEN);
+        lith_merkle_hash_chunks(&t2, 0, data, len);
+        lith_merkle_build(&t2);
+        lith_merkle_root(&t2, exp);
+        data[i * CHUNK_LEN + 5] ^= 0x80;
+        if (memcmp(root, exp, H) != 0)
+        {
+            printf("FAIL update of chunk %zu of %zu\n", i, n);
+            return EXIT_FAILURE;
+        }
+
+        /* Chunks past the end are rejected and leave the tree unchanged. */
+        memset(proof, 0xA5, sizeof proof);
+        if (lith_merkle_proof(&t, n, proof) != 0 ||
+            lith_merkle_proof(&t, 2 * 64, proof) != 0 ||
+            lith_merkle_proof(&t, SIZE_MAX, proof) != 0 || proof[0] != 0xA5)
+        {
+            printf("FAIL proof of chunk past the end of %zu\n", n);
+            return EXIT_FAILURE;
+        }
+        if (lith_merkle_update(&t, n, data, CHUNK_LEN) ||
+            lith_merkle_hash_chunks(&t, n, data, 1) ||
+            lith_merkle_hash_chunks(&t, n + 1, data, 0) ||
+            lith_merkle_hash_chunks(&t, 0, data, n * CHUNK_LEN + 1) ||
+            lith_merkle_hash_chunks(&t, n - 1, data, CHUNK_LEN + 1) ||
+            lith_merkle_hash_chunks(&t, 1, data, SIZE_MAX))
+        {
+            printf("FAIL out of range chunks of %zu accepted\n", n);
+            return EXIT_FAILURE;
+        }
+        if (!lith_merkle_hash_chunks(&t, n, data, 0))
+        {
+            printf("FAIL empty range at the end of %zu chunks\n", n);
+            return EXIT_FAILURE;
+        }
+        lith_merkle_root(&t, exp);
+        if (memcmp(root, exp, H) != 0)
+        {
+            printf("FAIL rejected chunks of %zu changed the tree\n", n);
+            return EXIT_FAILURE;
+        }
+    }
+    return EXIT_SUCCESS;
+}
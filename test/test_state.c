@@ -0,0 +1,147 @@
+/*
+ * Part of liblithium, under the Apache License v2.0.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <lithium/gimli_aead.h>
+#include <lithium/gimli_hash.h>
+#include <lithium/gimli_state.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define LEN 300
+
+int main(void)
+{
+    static const unsigned char n[GIMLI_AEAD_NONCE_LEN] = {3},
+                               k[GIMLI_AEAD_KEY_LEN] = {4};
+    unsigned char m[LEN], c[LEN], cr[LEN], t[16], tr[16];
+    unsigned char h[GIMLI_HASH_DEFAULT_LEN], hr[GIMLI_HASH_DEFAULT_LEN];
+    unsigned char saved[GIMLI_STATE_EXPORT_LEN];
+    gimli_state g, r;
+    gimli_xof_state x, xr;
+
+    for (size_t i = 0; i < LEN; ++i)
+    {
+        m[i] = (unsigned char)(i ^ 0x5A);
+    }
+
+    /* The serialized form is little-endian words, then the offset. */
+    memset(&g, 0, sizeof g);
+    g.state[0] = UINT32_C(0x04030201);
+    g.state[GIMLI_WORDS - 1] = UINT32_C(0xDDCCBBAA);
+    g.offset = 7;
+    gimli_state_export(saved, &g);
+    if (saved[0] != 1 || saved[3] != 4 || saved[44] != 0xAA ||
+        saved[47] != 0xDD || saved[48] != 7)
+    {
+        printf("FAIL unexpected export layout\n");
+        return EXIT_FAILURE;
+    }
+    /* Offsets from the rate up are never left by absorbing. */
+    for (unsigned offset = 16; offset <= 255; ++offset)
+    {
+        saved[48] = (unsigned char)offset;
+        if (gimli_state_import(&r, saved))
+        {
+            printf("FAIL imported offset %u\n", offset);
+            return EXIT_FAILURE;
+        }
+    }
+
+    /* Checkpoint a hash at every split point and resume from the copy. */
+    gimli_hash(h, sizeof h, m, LEN);
+    for (size_t split = 0; split <= LEN; split += 37)
+    {
+        gimli_hash_init(&g);
+        gimli_hash_update(&g, m, split);
+        gimli_state_export(saved, &g);
+        memset(&r, 0xFF, sizeof r);
+        if (!gimli_state_import(&r, saved))
+        {
+            printf("FAIL gimli_state_import\n");
+            return EXIT_FAILURE;
+        }
+        gimli_hash_update(&r, &m[split], LEN - split);
+        gimli_hash_final(&r, hr, sizeof hr);
+        if (memcmp(h, hr, sizeof h) != 0)
+        {
+            printf("FAIL resumed hash at %zu\n", split);
+            return EXIT_FAILURE;
+        }
+
+        /* A clone continues independently of the original. */
+        gimli_hash_clone(&r, &g);
+        gimli_hash_update(&g, m, 5);
+        gimli_hash_update(&r, &m[split], LEN - split);
+        gimli_hash_final(&r, hr, sizeof hr);
+        if (memcmp(h, hr, sizeof h) != 0)
+        {
+            printf("FAIL cloned hash at %zu\n", split);
+            return EXIT_FAILURE;
+        }
+    }
+
+    /* Checkpoint an AEAD state partway through the message. */
+    gimli_aead_encrypt(c, t, sizeof t, m, LEN, m, 20, n, k);
+    gimli_aead_init(&g, n, k);
+    gimli_aead_update_ad(&g, m, 20);
+    gimli_aead_final_ad(&g);
+    gimli_aead_encrypt_update(&g, cr, m, 123);
+    gimli_state_export(saved, &g);
+    if (!gimli_state_import(&r, saved))
+    {
+        printf("FAIL gimli_state_import\n");
+        return EXIT_FAILURE;
+    }
+    gimli_aead_encrypt_update(&r, &cr[123], &m[123], LEN - 123);
+    gimli_aead_encrypt_final(&r, tr, sizeof tr);
+    if (memcmp(c, cr, LEN) != 0 || memcmp(t, tr, sizeof t) != 0)
+    {
+        printf("FAIL resumed AEAD\n");
+        return EXIT_FAILURE;
+    }
+
+    /* Checkpoint an XOF at every position in an output block. */
+    gimli_hash_init(&g);
+    gimli_hash_update(&g, m, 50);
+    r = g;
+    gimli_hash_final(&r, c, LEN);
+    for (size_t split = 0; split <= 40; ++split)
+    {
+        gimli_xof_init(&x, &g);
+        gimli_xof_squeeze(&x, cr, split);
+        gimli_xof_export(saved, &x);
+        if (gimli_state_import(&r, saved))
+        {
+            printf("FAIL imported an XOF state as a gimli_state\n");
+            return EXIT_FAILURE;
+        }
+        if (!gimli_xof_import(&xr, saved))
+        {
+            printf("FAIL gimli_xof_import\n");
+            return EXIT_FAILURE;
+        }
+        gimli_xof_squeeze(&xr, &cr[split], LEN - split);
+        if (memcmp(c, cr, LEN) != 0)
+        {
+            printf("FAIL resumed XOF at %zu\n", split);
+            return EXIT_FAILURE;
+        }
+    }
+    gimli_state_export(saved, &g);
+    if (gimli_xof_import(&xr, saved))
+    {
+        printf("FAIL imported an absorbing state as an XOF state\n");
+        return EXIT_FAILURE;
+    }
+    saved[48] = 2 * 16 + 1;
+    if (gimli_xof_import(&xr, saved))
+    {
+        printf("FAIL imported an invalid XOF offset\n");
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,111 @@
+/*
+ * Part of liblithium, under the Apache License v2.0.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <lithium/gimli_hash.h>
+#include <lithium/gimli_tree_hash.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define LEAF GIMLI_TREE_HASH_LEAF_LEN
+#define CV GIMLI_TREE_HASH_CV_LEN
+#define MAX_LEAVES 19
+#define MAX_LEN (MAX_LEAVES * LEAF)
+
+/* Direct implementation of the tree hash definition in gimli_tree_hash.h. */
+static void reference(unsigned char h[GIMLI_HASH_DEFAULT_LEN],
+                      const unsigned char *m, size_t len)
+{
+    static const unsigned char leaf_domain = 0x00, root_domain = 0x01;
+    gimli_hash_state root, leaf;
+    unsigned char cv[CV], count[8] = {0};
+    size_t n = 0;
+
+    gimli_hash_init(&root);
+    do
+    {
+        const size_t leaf_len = len < LEAF ? len : LEAF;
+        gimli_hash_init(&leaf);
+        gimli_hash_update(&leaf, m, leaf_len);
+        gimli_hash_update(&leaf, &leaf_domain, 1);
+        gimli_hash_final(&leaf, cv, sizeof cv);
+        gimli_hash_update(&root, cv, sizeof cv);
+        m += leaf_len;
+        len -= leaf_len;
+        ++n;
+    } while (len > 0);
+    count[0] = (unsigned char)n;
+    count[1] = (unsigned char)(n >> 8);
+    gimli_hash_update(&root, count, sizeof count);
+    gimli_hash_update(&root, &root_domain, 1);
+    gimli_hash_final(&root, h, GIMLI_HASH_DEFAULT_LEN);
+}
+
+static const size_t lens[] = {
+    0,        1,        15,        16,
+    LEAF - 1, LEAF,     LEAF + 1,  2 * LEAF,
+    8 * LEAF, 9 * LEAF, 9 * LEAF + 5, 16 * LEAF + 1,
+    MAX_LEN - 3,
+};
+
+static const size_t chunks[] = {
+    1, 7, 16, 1000, 4096, LEAF, 3 * LEAF + 17, 8 * LEAF + 1,
+};
+
+int main(void)
+{
+    static unsigned char m[MAX_LEN], cvs[MAX_LEAVES * CV];
+    unsigned char exp[GIMLI_HASH_DEFAULT_LEN], h[GIMLI_HASH_DEFAULT_LEN];
+    gimli_tree_hash_state t;
+
+    for (size_t i = 0; i < MAX_LEN; ++i)
+    {
+        m[i] = (unsigned char)(i * 131 + (i >> 9));
+    }
+
+    for (size_t i = 0; i < sizeof lens / sizeof lens[0]; ++i)
+    {
+        const size_t len = lens[i];
+        reference(exp, m, len);
+
+        gimli_tree_hash(h, sizeof h, m, len);
+        if (memcmp(h, exp, sizeof h) != 0)
+        {
+            printf("FAIL gimli_tree_hash len %zu\n", len);
+            return EXIT_FAILURE;
+        }
+
+        for (size_t j = 0; j < sizeof chunks / sizeof chunks[0]; ++j)
+        {
+            gimli_tree_hash_init(&t);
+            for (size_t off = 0; off < len; off += chunks[j])
+            {
+                const size_t n = len - off < chunks[j] ? len - off : chunks[j];
+                gimli_tree_hash_update(&t, &m[off], n);
+            }
+            gimli_tree_hash_final(&t, h, sizeof h);
+            if (memcmp(h, exp, sizeof h) != 0)
+            {
+                printf("FAIL len %zu in chunks of %zu\n", len, chunks[j]);
+                return EXIT_FAILURE;
+            }
+        }
+
+        /* Whole leaves via chaining values, then the remainder. */
+        const size_t leaves = len / LEAF;
+        gimli_tree_hash_init(&t);
+        gimli_tree_hash_leaves(cvs, m, leaves);
+        gimli_tree_hash_update_cvs(&t, cvs, leaves);
+        gimli_tree_hash_update(&t, &m[leaves * LEAF], len % LEAF);
+        gimli_tree_hash_final(&t, h, sizeof h);
+        if (memcmp(h, exp, sizeof h) != 0)
+        {
+            printf("FAIL len %zu with gimli_tree_hash_leaves\n", len);
+            return EXIT_FAILURE;
+        }
+    }
+    return EXIT_SUCCESS;
+}
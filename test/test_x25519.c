@@ -79,6 +79,61 @@ int main(void)
         }
     }
 
+    /*
+     * The fixed-base functions agree with the ladder on the base point, and a
+     * multiple of L gives the identity, whose u-coordinate is 0.
+     */
+    static const unsigned char nine[X25519_LEN] = {9}, zero[X25519_LEN] = {0},
+                               L[X25519_LEN] = {
+                                   0xED, 0xD3, 0xF5, 0x5C, 0x1A, 0x63, 0x12,
+                                   0x58, 0xD6, 0x9C, 0xF7, 0xA2, 0xDE, 0xF9,
+                                   0xDE, 0x14, 0x00, 0x00, 0x00, 0x00, 0x00,
+                                   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+                                   0x00, 0x00, 0x00, 0x10,
+                               };
+    for (int i = 0; i < 10; i++)
+    {
+        randomize(secret1);
+        x25519_base(public1, secret1);
+        x25519(public2, secret1, nine);
+        if (memcmp(public1, public2, X25519_LEN) != 0)
+        {
+            printf("FAIL base %d\n", i);
+            return EXIT_FAILURE;
+        }
+    }
+    x25519_base_uniform(public1, zero);
+    x25519_base_uniform(public2, L);
+    if (memcmp(public1, zero, X25519_LEN) != 0 ||
+        memcmp(public2, zero, X25519_LEN) != 0)
+    {
+        printf("FAIL base identity\n");
+        return EXIT_FAILURE;
+    }
+
+    /*
+     * Verification depends only on the response mod L, and a zero response
+     * with a zero public key is rejected.
+     */
+    randomize(secret1);
+    x25519_base_uniform(public1, secret1);
+    randomize(eph_secret);
+    x25519_base_uniform(eph_public, eph_secret);
+    randomize(challenge);
+    x25519_sign(response, challenge, eph_secret, secret1);
+    for (int i = 0, carry = 0; i < X25519_LEN; i++)
+    {
+        carry += response[i] + L[i];
+        response[i] = (unsigned char)carry;
+        carry >>= 8;
+    }
+    if (!x25519_verify(response, challenge, eph_public, public1) ||
+        x25519_verify(zero, challenge, eph_public, zero))
+    {
+        printf("FAIL verify mod L\n");
+        return EXIT_FAILURE;
+    }
+
     unsigned char base[X25519_LEN] = {9};
     unsigned char key[X25519_LEN] = {9};
     unsigned char *b = base, *k = key, *tmp;
@@ -181,4 +236,43 @@ int main(void)
             return EXIT_FAILURE;
         }
     }
+
+    /*
+     * x25519_batch agrees with x25519 on the RFC7748 vectors and on random
+     * inputs, over more than one chunk of shared inversions, and the point
+     * u = 0 in the middle of the batch only zeroes its own result.
+     */
+    enum
+    {
+        BATCH = 37
+    };
+    static unsigned char bsc[BATCH][X25519_LEN], bu[BATCH][X25519_LEN],
+        bout[BATCH][X25519_LEN];
+    unsigned char *outs[BATCH];
+    const unsigned char *scs[BATCH], *us[BATCH];
+    for (size_t i = 0; i < BATCH; ++i)
+    {
+        randomize(bsc[i]);
+        randomize(bu[i]);
+        outs[i] = bout[i];
+        scs[i] = bsc[i];
+        us[i] = bu[i];
+    }
+    for (size_t t = 0; t < sizeof(tv) / sizeof(tv[0]); ++t)
+    {
+        memcpy(bsc[t], tv[t].sc, X25519_LEN);
+        memcpy(bu[t], tv[t].u, X25519_LEN);
+    }
+    memset(bu[20], 0, X25519_LEN);
+    x25519_batch(outs, scs, us, BATCH);
+    for (size_t i = 0; i < BATCH; ++i)
+    {
+        unsigned char exp[X25519_LEN];
+        x25519(exp, bsc[i], bu[i]);
+        if (memcmp(exp, bout[i], X25519_LEN) != 0)
+        {
+            printf("FAIL batch %zu\n", i);
+            return EXIT_FAILURE;
+        }
+    }
 }